@@ -1,231 +1,6484 @@
 #pragma once
 
 #include <random>
+#include <algorithm>
 #include <ranges>
 #include <concepts>
 #include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <bit>
 #include <type_traits>
+#include <cmath>
+#include <iterator>
+#include <thread>
+#include <vector>
+#include <unordered_set>
+#include <span>
+#include <chrono>
+#include <string>
+#include <array>
+#include <string_view>
+#include <limits>
+#include <utility>
+#include <memory>
+#include <new>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
 
+#if defined(__linux__)
+	#include <sched.h>
+	#include <sys/mman.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+
+	// Per-CPU engines of NumaPoolEngine are placed with sched_getcpu, sysfs and mbind
+	#define RANDOM_NUMA_LINUX
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+	#define RANDOM_ALWAYS_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+	#define RANDOM_ALWAYS_INLINE __forceinline
+#else
+	#define RANDOM_ALWAYS_INLINE inline
+#endif
+
+// Bulk kernels are compiled for several instruction sets and selected at runtime
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	#define RANDOM_X86_DISPATCH
+	#define RANDOM_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+	#define RANDOM_VECTOR_EXTENSIONS
+#endif
+
+// Functions callable from both host and device code of CUDA and HIP
+#if defined(__CUDACC__) || defined(__HIPCC__)
+	#define RANDOM_HOST_DEVICE __host__ __device__
+#else
+	#define RANDOM_HOST_DEVICE
+#endif
+
+// Requests the cache line of an address ahead of a load
+#if defined(__GNUC__) || defined(__clang__)
+	#define RANDOM_PREFETCH(address) __builtin_prefetch(address)
+#else
+	#define RANDOM_PREFETCH(address) static_cast<void>(address)
+#endif
+
+// Unrolls short loops with a constant trip count, such as the rounds of a block cipher
+#if defined(__clang__)
+	#define RANDOM_UNROLL _Pragma("unroll")
+#elif defined(__GNUC__)
+	#define RANDOM_UNROLL _Pragma("GCC unroll 16")
+#else
+	#define RANDOM_UNROLL
+#endif
 
 template<typename TRange>
 concept IsArithmeticRange = std::ranges::range<TRange> &&
 							std::is_arithmetic_v<std::ranges::range_value_t<TRange>>;
 
-class Random
+/// <summary>
+/// Object that makes an arithmetic random value from a random bit generator,
+/// such as NormalDistribution or BoundedSampler
+/// </summary>
+template<typename TDistribution>
+concept IsDistribution = std::invocable<const TDistribution&, std::mt19937_64&> &&
+						 std::is_arithmetic_v<std::invoke_result_t<const TDistribution&, std::mt19937_64&>>;
+
+/// <summary>
+/// Opt-in counters of the hot paths: calls of the BasicRandom methods, engine outputs taken
+/// through RandomBits, rejection sampling retries and waits on the mutex of BasicSharedRandom.
+/// Define RANDOM_ENABLE_STATISTICS before including the header to turn them on, otherwise
+/// every counter compiles to nothing. Each thread writes its own counters without atomic
+/// read-modify-write, Take() sums them for a metrics exporter.
+/// </summary>
+class RandomStatistics
 {
-protected:	
-	static inline std::default_random_engine _engine;
-	std::random_device _device;
 public:
-	Random() noexcept
+	enum class Method: std::size_t
+	{
+		Next,
+		NextInt,
+		NextInt64,
+		NextBounded,
+		NextWeighted,
+		NextDouble,
+		NextFloat,
+		NextNormal,
+		NextExponential,
+		NextPoisson,
+		NextDistribution,
+		Fill,
+		FillBytes,
+		WriteBytes,
+		FillChars,
+		Shuffle,
+		PartialShuffle,
+		Sample,
+		SampleWithReplacement,
+		Choice,
+		ParallelFill,
+		ParallelShuffle,
+		SampleView,
+		ShuffledView,
+		MakePermutation,
+		Count
+	};
+
+	static constexpr std::size_t MethodCount = static_cast<std::size_t>(Method::Count);
+
+#if defined(RANDOM_ENABLE_STATISTICS)
+	static constexpr bool Enabled = true;
+#else
+	static constexpr bool Enabled = false;
+#endif
+
+	/// <summary>
+	/// Values of the counters since the start of the program or the last Reset()
+	/// </summary>
+	struct Snapshot
+	{
+		std::uint64_t Calls[MethodCount]{};
+		std::uint64_t EngineDraws = 0;
+		std::uint64_t Rejections = 0;
+		std::uint64_t LockAcquisitions = 0;
+		std::uint64_t ContendedAcquisitions = 0;
+		std::uint64_t LockWaitNanoseconds = 0;
+
+		constexpr std::uint64_t CallsOf(Method method) const noexcept
+		{
+			return Calls[static_cast<std::size_t>(method)];
+		}
+	};
+private:
+	enum Slot: std::size_t
+	{
+		EngineDrawsSlot = MethodCount,
+		RejectionsSlot,
+		LockAcquisitionsSlot,
+		ContendedAcquisitionsSlot,
+		LockWaitSlot,
+		SlotCount
+	};
+
+	struct ThreadCounters;
+
+	struct Registry
+	{
+		std::mutex Mutex;
+		std::vector<const ThreadCounters*> Threads;
+		std::uint64_t Retired[SlotCount]{};
+		std::uint64_t Baseline[SlotCount]{};
+	};
+
+	struct ThreadCounters
+	{
+		std::atomic<std::uint64_t> Values[SlotCount]{};
+
+		ThreadCounters() noexcept
+		{
+			Registry& registry = GetRegistry();
+			std::lock_guard<std::mutex> lock(registry.Mutex);
+			registry.Threads.push_back(this);
+		}
+
+		~ThreadCounters()
+		{
+			Registry& registry = GetRegistry();
+			std::lock_guard<std::mutex> lock(registry.Mutex);
+
+			for(std::size_t slot = 0; slot < SlotCount; slot++)
+			{
+				registry.Retired[slot] += Values[slot].load(std::memory_order_relaxed);
+			}
+
+			std::erase(registry.Threads, this);
+		}
+	};
+
+	static Registry& GetRegistry() noexcept
 	{
-		_engine.seed(_device());
+		static Registry registry;
+		return registry;
 	}
 
-	Random(unsigned int seed) noexcept
+	static void Add(std::size_t slot, std::uint64_t value) noexcept
 	{
-		_engine.seed(seed);
+		static thread_local ThreadCounters counters;
+		std::atomic<std::uint64_t>& counter = counters.Values[slot];
+
+		// Only this thread writes the counter, a plain store is enough
+		counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
 	}
 
+	static void Sum(Registry& registry, std::uint64_t (&values)[SlotCount]) noexcept
+	{
+		std::copy(std::begin(registry.Retired), std::end(registry.Retired), values);
+
+		for(const ThreadCounters* counters : registry.Threads)
+		{
+			for(std::size_t slot = 0; slot < SlotCount; slot++)
+			{
+				values[slot] += counters->Values[slot].load(std::memory_order_relaxed);
+			}
+		}
+	}
+public:
 	/// <summary>
-	/// Generate a random unsigned int number in a range [0, max]
+	/// Count a call of a BasicRandom method
 	/// </summary>
-	/// <param name="max"> - maximum value</param>
-	/// <returns>a random unsigned int number in a range [0, max]</returns>
-	unsigned int Next(unsigned int max) noexcept
+	static constexpr void CountCall(Method method) noexcept
 	{
-		return std::uniform_int_distribution<>(0, max)(_engine);
+		if constexpr(Enabled)
+		{
+			if(!std::is_constant_evaluated())
+			{
+				Add(static_cast<std::size_t>(method), 1);
+			}
+		}
 	}
 
 	/// <summary>
-	/// Generate a random int number in a range [min, max]
+	/// Count engine outputs taken to make one value
 	/// </summary>
-	/// <param name="min"> - minimal value</param>
-	/// <param name="max"> - maximum value</param>
-	/// <returns>a random number in a range [min, max]</returns>
-	int NextInt(int min, int max) noexcept
+	static constexpr void CountDraws(std::uint64_t count) noexcept
 	{
-		return std::uniform_int_distribution<>(min, max)(_engine);
+		if constexpr(Enabled)
+		{
+			if(!std::is_constant_evaluated())
+			{
+				Add(EngineDrawsSlot, count);
+			}
+		}
 	}
 
 	/// <summary>
-	/// Generate a random real number in a range [min, max]
+	/// Count a rejected candidate of rejection sampling
 	/// </summary>
-	/// <param name="min"> - minimal value</param>
-	/// <param name="max"> - maximum value</param>
-	/// <returns>a random real number in a range [min, max]</returns>
-	double NextDouble(double min, double max) noexcept
+	static constexpr void CountRejection() noexcept
 	{
-		return std::uniform_real_distribution<>(min, max)(_engine);
+		if constexpr(Enabled)
+		{
+			if(!std::is_constant_evaluated())
+			{
+				Add(RejectionsSlot, 1);
+			}
+		}
 	}
 
 	/// <summary>
-	/// Generate a random real number in a range [0, 1]
+	/// Count an acquisition of a mutex and the time spent waiting for it
 	/// </summary>
-	/// <returns>a random real number in a range [0, 1]</returns>
-	double NextDouble() noexcept
+	static void CountLock(bool contended, std::uint64_t waitNanoseconds) noexcept
 	{
-		NextDouble(0.0, 1.0);
+		if constexpr(Enabled)
+		{
+			Add(LockAcquisitionsSlot, 1);
+
+			if(contended)
+			{
+				Add(ContendedAcquisitionsSlot, 1);
+				Add(LockWaitSlot, waitNanoseconds);
+			}
+		}
 	}
 
 	/// <summary>
-	/// Fill a numeric range with random int numbers in a range [min, max]
+	/// Sum the counters of all threads, including the finished ones.
+	/// Counters of running threads may lag by a few increments.
 	/// </summary>
-	/// <param name="range"> - numeric range</param>
-	/// <param name="min"> - minimal value</param>
-	/// <param name="max"> - maximum value</param>
-	template<typename TRange> requires IsArithmeticRange<TRange>
-	void Fill(TRange&& range, int min, int max) noexcept
+	/// <returns>the counters since the last Reset(), zeros when the statistics are disabled</returns>
+	static Snapshot Take() noexcept
 	{
-		for(auto& item : range)
+		Snapshot snapshot;
+
+		if constexpr(Enabled)
 		{
-			item = std::uniform_int_distribution<>(min, max)(_engine);
+			Registry& registry = GetRegistry();
+			std::uint64_t values[SlotCount];
+			std::lock_guard<std::mutex> lock(registry.Mutex);
+
+			Sum(registry, values);
+
+			for(std::size_t slot = 0; slot < SlotCount; slot++)
+			{
+				values[slot] -= registry.Baseline[slot];
+			}
+
+			std::copy(values, values + MethodCount, snapshot.Calls);
+			snapshot.EngineDraws = values[EngineDrawsSlot];
+			snapshot.Rejections = values[RejectionsSlot];
+			snapshot.LockAcquisitions = values[LockAcquisitionsSlot];
+			snapshot.ContendedAcquisitions = values[ContendedAcquisitionsSlot];
+			snapshot.LockWaitNanoseconds = values[LockWaitSlot];
 		}
+
+		return snapshot;
 	}
 
 	/// <summary>
-	/// Fill a numeric range with random double numbers in a range [min, max]
+	/// Start counting from zero. The counters themselves keep growing, Take() subtracts their values at the reset.
 	/// </summary>
-	/// <param name="range"> - numeric range</param>
-	/// <param name="min"> - minimal value</param>
-	/// <param name="max"> - maximum value</param>
-	template<typename TRange> requires IsArithmeticRange<TRange>
-	void Fill(TRange&& range, double min, double max) noexcept
+	static void Reset() noexcept
 	{
-		for(auto& item : range)
+		if constexpr(Enabled)
 		{
-			item = std::uniform_real_distribution<>(min, max)(_engine);
+			Registry& registry = GetRegistry();
+			std::lock_guard<std::mutex> lock(registry.Mutex);
+
+			Sum(registry, registry.Baseline);
 		}
 	}
 
 	/// <summary>
-	/// Fill a numeric range with random double numbers in a range [0, 1]
+	/// Name of a method for metric labels
 	/// </summary>
-	/// <param name="range"> - numeric range</param>
-	template<typename TRange> requires IsArithmeticRange<TRange>
-	void Fill(TRange&& range) noexcept
+	static constexpr std::string_view Name(Method method) noexcept
 	{
-		for(auto& item : range)
+		constexpr std::string_view names[MethodCount + 1] =
 		{
-			item = std::uniform_real_distribution<>(0, 1)(_engine);
-		}
+			"Next", "NextInt", "NextInt64", "NextBounded", "NextWeighted", "NextDouble", "NextFloat",
+			"NextNormal", "NextExponential", "NextPoisson", "NextDistribution", "Fill", "FillBytes",
+			"WriteBytes", "FillChars", "Shuffle", "PartialShuffle", "Sample", "SampleWithReplacement", "Choice",
+			"ParallelFill", "ParallelShuffle", "SampleView", "ShuffledView", "MakePermutation", "Count"
+		};
+
+		return names[static_cast<std::size_t>(method)];
+	}
+};
+
+/// <summary>
+/// std::lock_guard for the mutex of a shared object. With RANDOM_ENABLE_STATISTICS it first
+/// tries to take the mutex without blocking, and counts the contended waits and their time.
+/// </summary>
+class RandomLockGuard
+{
+	std::mutex& _mutex;
+public:
+	explicit RandomLockGuard(std::mutex& mutex) noexcept:
+		_mutex(mutex)
+	{
+		Lock(_mutex);
+	}
+
+	~RandomLockGuard()
+	{
+		_mutex.unlock();
 	}
 
+	RandomLockGuard(const RandomLockGuard&) = delete;
+	RandomLockGuard& operator=(const RandomLockGuard&) = delete;
+
 	/// <summary>
-	/// Reorders the elements in the given range such
-	/// that each possible permutation of those elements has equal probability of appearance.
+	/// Lock the mutex and count the acquisition
 	/// </summary>
-	/// <param name="range"> - 	the range of elements to shuffle randomly</param>
-	template<typename TRange> requires std::ranges::random_access_range<TRange>
-	void Shuffle(TRange&& range) noexcept
+	static void Lock(std::mutex& mutex) noexcept
 	{
-		std::ranges::shuffle(std::forward<TRange>(range), _engine);
+		if constexpr(RandomStatistics::Enabled)
+		{
+			if(mutex.try_lock())
+			{
+				RandomStatistics::CountLock(false, 0);
+				return;
+			}
+
+			const auto start = std::chrono::steady_clock::now();
+
+			mutex.lock();
+			RandomStatistics::CountLock(true, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+		}
+		else
+		{
+			mutex.lock();
+		}
 	}
 };
 
-class SharedRandom: public Random
+/// <summary>
+/// Helpers that take raw bits from any std::uniform_random_bit_generator
+/// </summary>
+class RandomBits
 {
 protected:
-	static inline std::mutex _mutex;
-public:
-	SharedRandom() noexcept:
-		Random()
-	{}
+	/// <summary>
+	/// Engine that counts each of its calls as one draw, for std::uniform_int_distribution
+	/// which may call an engine of a narrow range several times and retry
+	/// </summary>
+	template<typename TEngine>
+	struct CountedEngine
+	{
+		using result_type = typename TEngine::result_type;
 
-	SharedRandom(unsigned int seed) noexcept:
-		Random(seed)
-	{}
+		TEngine& Engine;
+
+		static constexpr result_type min() noexcept
+		{
+			return TEngine::min();
+		}
+
+		static constexpr result_type max() noexcept
+		{
+			return TEngine::max();
+		}
+
+		result_type operator()() noexcept
+		{
+			RandomStatistics::CountDraws(1);
+			return Engine();
+		}
+	};
 
+	template<typename TResult, typename TEngine>
+	static TResult Distribute(TEngine& engine) noexcept
+	{
+		if constexpr(RandomStatistics::Enabled)
+		{
+			CountedEngine<TEngine> counted{ engine };
+			return std::uniform_int_distribution<TResult>()(counted);
+		}
+		else
+		{
+			return std::uniform_int_distribution<TResult>()(engine);
+		}
+	}
+public:
 	/// <summary>
-	/// Generate a random uint32 number in a range [0, max]
+	/// Take 64 random bits whatever the output range of the generator is
 	/// </summary>
-	/// <param name="max"> - maximum value</param>
-	/// <returns>a random uint32 number in a range [0, max]</returns>
-	unsigned int Next(unsigned int max) noexcept
+	/// <param name="generator"> - random bit generator</param>
+	/// <returns>64 random bits</returns>
+	template<typename TGenerator> requires std::uniform_random_bit_generator<std::remove_reference_t<TGenerator>>
+	static constexpr std::uint64_t Next64(TGenerator&& generator) noexcept
 	{
-		std::lock_guard<std::mutex> lock(_mutex);
-		return Random::Next(max);
+		using TEngine = std::remove_reference_t<TGenerator>;
+
+		if constexpr(TEngine::min() == 0 && TEngine::max() == UINT64_MAX)
+		{
+			RandomStatistics::CountDraws(1);
+			return generator();
+		}
+		else if constexpr(TEngine::min() == 0 && TEngine::max() == UINT32_MAX)
+		{
+			RandomStatistics::CountDraws(2);
+			return (std::uint64_t(generator()) << 32) | generator();
+		}
+		else
+		{
+			return Distribute<std::uint64_t>(generator);
+		}
 	}
 
 	/// <summary>
-	/// Generate a random int number in a range [min, max]
+	/// Take 32 random bits whatever the output range of the generator is
 	/// </summary>
-	/// <param name="min"> - minimal value</param>
-	/// <param name="max"> - maximum value</param>
-	/// <returns>a random number in a range [min, max]</returns>
-	int NextInt(int min, int max) noexcept
+	/// <param name="generator"> - random bit generator</param>
+	/// <returns>32 random bits</returns>
+	template<typename TGenerator> requires std::uniform_random_bit_generator<std::remove_reference_t<TGenerator>>
+	static constexpr std::uint32_t Next32(TGenerator&& generator) noexcept
 	{
-		std::lock_guard<std::mutex> lock(_mutex);
-		return Random::NextInt(min, max);
+		using TEngine = std::remove_reference_t<TGenerator>;
+
+		if constexpr(TEngine::min() == 0 && TEngine::max() == UINT32_MAX)
+		{
+			RandomStatistics::CountDraws(1);
+			return static_cast<std::uint32_t>(generator());
+		}
+		else if constexpr(TEngine::min() == 0 && TEngine::max() == UINT64_MAX)
+		{
+			RandomStatistics::CountDraws(1);
+			return static_cast<std::uint32_t>(generator() >> 32);
+		}
+		else
+		{
+			return Distribute<std::uint32_t>(generator);
+		}
 	}
 
 	/// <summary>
-	/// Generate a random real number in a range [min, max]
+	/// Map 64 random bits to a double in a range [0, 1) with all 53 bits of the mantissa
 	/// </summary>
-	/// <param name="min"> - minimal value</param>
-	/// <param name="max"> - maximum value</param>
-	/// <returns>a random real number in a range [min, max]</returns>
-	double NextDouble(double min, double max) noexcept
+	/// <param name="bits"> - random bits</param>
+	/// <returns>a multiple of 2^-53 in a range [0, 1)</returns>
+	static constexpr double ToDouble(std::uint64_t bits) noexcept
 	{
-		std::lock_guard<std::mutex> lock(_mutex);
-		return Random::NextDouble(min, max);
+		return static_cast<double>(bits >> 11) * 0x1.0p-53;
 	}
 
 	/// <summary>
-	/// Generate a random real number in a range [0, 1]
+	/// Map 32 random bits to a float in a range [0, 1) with all 24 bits of the mantissa
 	/// </summary>
-	/// <returns>a random real number in a range [0, 1]</returns>
-	double NextDouble() noexcept
+	/// <param name="bits"> - random bits</param>
+	/// <returns>a multiple of 2^-24 in a range [0, 1)</returns>
+	static constexpr float ToFloat(std::uint32_t bits) noexcept
 	{
-		Random::NextDouble(0.0, 1.0);
+		return static_cast<float>(bits >> 8) * 0x1.0p-24f;
 	}
 
 	/// <summary>
-	/// Fill a numeric range with random int numbers in a range [min, max]
+	/// The greatest number of a range [min, max). min + (max - min) * u with u less than 1
+	/// may round up to max, so results are clamped to this bound.
 	/// </summary>
-	/// <param name="range"> - numeric range</param>
-	/// <param name="min"> - minimal value</param>
-	/// <param name="max"> - maximum value</param>
-	template<typename TRange> requires IsArithmeticRange<TRange>
-	void Fill(TRange&& range, int min, int max) noexcept
+	/// <returns>the number before max, min itself if min is not less than max</returns>
+	template<typename TReal> requires std::is_floating_point_v<TReal>
+	static constexpr TReal UpperBound(TReal min, TReal max) noexcept
 	{
-		std::lock_guard<std::mutex> lock(_mutex);
-		Random::Fill(std::forward<TRange>(range), min, max);
+		if(!(min < max))
+		{
+			return min;
+		}
+
+		if constexpr(std::is_same_v<TReal, double> || std::is_same_v<TReal, float>)
+		{
+			using TBits = std::conditional_t<std::is_same_v<TReal, double>, std::uint64_t, std::uint32_t>;
+			const TBits bits = std::bit_cast<TBits>(max);
+
+			if(max == 0)
+			{
+				return -std::numeric_limits<TReal>::denorm_min();
+			}
+
+			return std::bit_cast<TReal>(max > 0 ? static_cast<TBits>(bits - 1) : static_cast<TBits>(bits + 1));
+		}
+		else
+		{
+			return std::nextafter(max, min);
+		}
 	}
 
 	/// <summary>
-	/// Fill a numeric range with random double numbers in a range [min, max]
+	/// The high 64 bits of the 128-bit product
 	/// </summary>
-	/// <param name="range"> - numeric range</param>
-	/// <param name="min"> - minimal value</param>
-	/// <param name="max"> - maximum value</param>
-	template<typename TRange> requires IsArithmeticRange<TRange>
-	void Fill(TRange&& range, double min, double max) noexcept
+	static constexpr std::uint64_t MultiplyHigh(std::uint64_t left, std::uint64_t right) noexcept
 	{
-		std::lock_guard<std::mutex> lock(_mutex);
-		Random::Fill(std::forward<TRange>(range), min, max);
+	#if defined(__SIZEOF_INT128__)
+		return static_cast<std::uint64_t>((static_cast<unsigned __int128>(left) * right) >> 64);
+	#else
+		const std::uint64_t leftLow = left & UINT32_MAX, leftHigh = left >> 32;
+		const std::uint64_t rightLow = right & UINT32_MAX, rightHigh = right >> 32;
+		const std::uint64_t lowLow = leftLow * rightLow;
+		const std::uint64_t highLow = leftHigh * rightLow;
+		const std::uint64_t lowHigh = leftLow * rightHigh;
+		const std::uint64_t middle = (lowLow >> 32) + (highLow & UINT32_MAX) + (lowHigh & UINT32_MAX);
+
+		return leftHigh * rightHigh + (highLow >> 32) + (lowHigh >> 32) + (middle >> 32);
+	#endif
+	}
+};
+
+/// <summary>
+/// SplitMix64 engine by S. Vigna. Satisfies std::uniform_random_bit_generator.
+/// The fastest of the included engines with a small 64-bit state and a period of 2^64.
+/// </summary>
+class SplitMix64
+{
+protected:
+	std::uint64_t _state;
+public:
+	using result_type = std::uint64_t;
+
+	static constexpr std::uint64_t Gamma = 0x9e3779b97f4a7c15;
+
+	constexpr SplitMix64() noexcept:
+		_state(0)
+	{}
+
+	explicit constexpr SplitMix64(std::uint64_t value) noexcept:
+		_state(value)
+	{}
+
+	static constexpr result_type min() noexcept
+	{
+		return 0;
+	}
+
+	static constexpr result_type max() noexcept
+	{
+		return UINT64_MAX;
 	}
 
 	/// <summary>
-	/// Fill a numeric range with random double numbers in a range [0, 1]
+	/// The finalizer of SplitMix64, a bijective 64-bit mixing function
 	/// </summary>
-	/// <param name="range"> - numeric range</param>
-	template<typename TRange> requires IsArithmeticRange<TRange>
-	void Fill(TRange&& range) noexcept
+	/// <param name="value"> - value to mix</param>
+	/// <returns>mixed value</returns>
+	static constexpr std::uint64_t Mix(std::uint64_t value) noexcept
 	{
-		std::lock_guard<std::mutex> lock(_mutex);
-		Random::Fill(std::forward<TRange>(range));
+		value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+		value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+		return value ^ (value >> 31);
+	}
+
+	constexpr void seed(std::uint64_t value) noexcept
+	{
+		_state = value;
+	}
+
+	constexpr result_type operator()() noexcept
+	{
+		_state += Gamma;
+		return Mix(_state);
+	}
+
+	constexpr void discard(unsigned long long count) noexcept
+	{
+		_state += Gamma * count;
+	}
+
+	friend constexpr bool operator==(const SplitMix64& left, const SplitMix64& right) noexcept = default;
+};
+
+/// <summary>
+/// xoshiro256++ engine by D. Blackman and S. Vigna.
+/// Satisfies std::uniform_random_bit_generator, has a period of 2^256 - 1
+/// and supports jumps that split the period into non-overlapping subsequences.
+/// </summary>
+class Xoshiro256PlusPlus
+{
+	friend class Xoshiro256PlusPlusX8;
+protected:
+	std::uint64_t _state[4]{};
+
+	static constexpr std::uint64_t RotateLeft(std::uint64_t value, int shift) noexcept
+	{
+		return (value << shift) | (value >> (64 - shift));
+	}
+
+	constexpr void Jump(const std::uint64_t (&polynomial)[4]) noexcept
+	{
+		std::uint64_t state[4] = {};
+
+		for(std::uint64_t word : polynomial)
+		{
+			for(int bit = 0; bit < 64; bit++)
+			{
+				if(word & (std::uint64_t(1) << bit))
+				{
+					for(int i = 0; i < 4; i++)
+					{
+						state[i] ^= _state[i];
+					}
+				}
+
+				(*this)();
+			}
+		}
+
+		for(int i = 0; i < 4; i++)
+		{
+			_state[i] = state[i];
+		}
+	}
+public:
+	using result_type = std::uint64_t;
+
+	constexpr Xoshiro256PlusPlus() noexcept
+	{
+		seed(0);
+	}
+
+	explicit constexpr Xoshiro256PlusPlus(std::uint64_t value) noexcept
+	{
+		seed(value);
+	}
+
+	static constexpr result_type min() noexcept
+	{
+		return 0;
+	}
+
+	static constexpr result_type max() noexcept
+	{
+		return UINT64_MAX;
 	}
 
 	/// <summary>
-	/// Reorders the elements in the given range such
-	/// that each possible permutation of those elements has equal probability of appearance.
+	/// Seed the engine expanding the value to the full state with SplitMix64
 	/// </summary>
-	/// <param name="range"> - 	the range of elements to shuffle randomly</param>
-	template<typename TRange> requires std::ranges::random_access_range<TRange>
-	void Shuffle(TRange&& range) noexcept
+	/// <param name="value"> - seed value</param>
+	constexpr void seed(std::uint64_t value) noexcept
 	{
-		std::lock_guard<std::mutex> lock(_mutex);
-		Random::Shuffle(std::forward<TRange>(range));
+		SplitMix64 expander(value);
+
+		for(auto& word : _state)
+		{
+			word = expander();
+		}
+	}
+
+	constexpr result_type operator()() noexcept
+	{
+		const std::uint64_t result = RotateLeft(_state[0] + _state[3], 23) + _state[0];
+		const std::uint64_t t = _state[1] << 17;
+
+		_state[2] ^= _state[0];
+		_state[3] ^= _state[1];
+		_state[1] ^= _state[2];
+		_state[0] ^= _state[3];
+		_state[2] ^= t;
+		_state[3] = RotateLeft(_state[3], 45);
+
+		return result;
 	}
+
+	constexpr void discard(unsigned long long count) noexcept
+	{
+		for(; count > 0; count--)
+		{
+			(*this)();
+		}
+	}
+
+	/// <summary>
+	/// Advance the engine by 2^128 steps.
+	/// Can be used to generate 2^128 non-overlapping subsequences.
+	/// </summary>
+	constexpr void jump() noexcept
+	{
+		Jump({ 0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c });
+	}
+
+	/// <summary>
+	/// Advance the engine by 2^192 steps.
+	/// Can be used to generate 2^64 starting points, from each of which
+	/// jump() will generate 2^64 non-overlapping subsequences.
+	/// </summary>
+	constexpr void long_jump() noexcept
+	{
+		Jump({ 0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241, 0x39109bb02acbe635 });
+	}
+
+	friend constexpr bool operator==(const Xoshiro256PlusPlus& left, const Xoshiro256PlusPlus& right) noexcept
+	{
+		for(int i = 0; i < 4; i++)
+		{
+			if(left._state[i] != right._state[i])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+};
+
+/// <summary>
+/// PCG64 (XSL RR 128/64) engine by M. O'Neill. Satisfies std::uniform_random_bit_generator.
+/// Has a 128-bit state, a period of 2^128, 2^127 selectable streams and O(log n) discard.
+/// </summary>
+class Pcg64
+{
+protected:
+	static constexpr std::uint64_t MultiplierHigh = 2549297995355413924;
+	static constexpr std::uint64_t MultiplierLow = 4865540595714422341;
+	static constexpr std::uint64_t IncrementHigh = 6364136223846793005;
+	static constexpr std::uint64_t IncrementLow = 1442695040888963407;
+
+	std::uint64_t _stateHigh = 0;
+	std::uint64_t _stateLow = 0;
+	std::uint64_t _incrementHigh = 0;
+	std::uint64_t _incrementLow = 0;
+
+	/// <summary>
+	/// state = state * multiplier + increment in 128-bit arithmetic
+	/// </summary>
+	static constexpr void MultiplyAdd(std::uint64_t& high, std::uint64_t& low,
+									  std::uint64_t multiplierHigh, std::uint64_t multiplierLow,
+									  std::uint64_t incrementHigh, std::uint64_t incrementLow) noexcept
+	{
+		const std::uint64_t productHigh = RandomBits::MultiplyHigh(low, multiplierLow) + high * multiplierLow + low * multiplierHigh;
+		const std::uint64_t productLow = low * multiplierLow;
+
+		low = productLow + incrementLow;
+		high = productHigh + incrementHigh + (low < productLow);
+	}
+
+	constexpr void Step() noexcept
+	{
+		MultiplyAdd(_stateHigh, _stateLow, MultiplierHigh, MultiplierLow, _incrementHigh, _incrementLow);
+	}
+
+	constexpr void Reset(std::uint64_t value) noexcept
+	{
+		_stateHigh = 0;
+		_stateLow = value + _incrementLow;
+		_stateHigh = _incrementHigh + (_stateLow < _incrementLow);
+		Step();
+	}
+public:
+	using result_type = std::uint64_t;
+
+	constexpr Pcg64() noexcept
+	{
+		seed(0);
+	}
+
+	explicit constexpr Pcg64(std::uint64_t value) noexcept
+	{
+		seed(value);
+	}
+
+	/// <summary>
+	/// Seed the engine and select one of its 2^127 streams
+	/// </summary>
+	/// <param name="value"> - seed value</param>
+	/// <param name="stream"> - stream number</param>
+	constexpr Pcg64(std::uint64_t value, std::uint64_t stream) noexcept
+	{
+		seed(value, stream);
+	}
+
+	static constexpr result_type min() noexcept
+	{
+		return 0;
+	}
+
+	static constexpr result_type max() noexcept
+	{
+		return UINT64_MAX;
+	}
+
+	constexpr void seed(std::uint64_t value) noexcept
+	{
+		_incrementHigh = IncrementHigh;
+		_incrementLow = IncrementLow;
+		Reset(value);
+	}
+
+	constexpr void seed(std::uint64_t value, std::uint64_t stream) noexcept
+	{
+		_incrementHigh = stream >> 63;
+		_incrementLow = (stream << 1) | 1;
+		Reset(value);
+	}
+
+	constexpr result_type operator()() noexcept
+	{
+		Step();
+
+		const std::uint64_t value = _stateHigh ^ _stateLow;
+		const int rotation = static_cast<int>(_stateHigh >> 58);
+
+		return (value >> rotation) | (value << ((64 - rotation) & 63));
+	}
+
+	/// <summary>
+	/// Advance the engine by count steps in O(log count) time
+	/// </summary>
+	/// <param name="count"> - number of steps</param>
+	constexpr void discard(unsigned long long count) noexcept
+	{
+		std::uint64_t multiplierHigh = MultiplierHigh, multiplierLow = MultiplierLow;
+		std::uint64_t incrementHigh = _incrementHigh, incrementLow = _incrementLow;
+		std::uint64_t accumulatedMultiplierHigh = 0, accumulatedMultiplierLow = 1;
+		std::uint64_t accumulatedIncrementHigh = 0, accumulatedIncrementLow = 0;
+
+		for(; count > 0; count >>= 1)
+		{
+			if(count & 1)
+			{
+				MultiplyAdd(accumulatedMultiplierHigh, accumulatedMultiplierLow, multiplierHigh, multiplierLow, 0, 0);
+				MultiplyAdd(accumulatedIncrementHigh, accumulatedIncrementLow, multiplierHigh, multiplierLow, incrementHigh, incrementLow);
+			}
+
+			// increment = (multiplier + 1) * increment, multiplier = multiplier^2
+			std::uint64_t nextIncrementHigh = incrementHigh, nextIncrementLow = incrementLow;
+			MultiplyAdd(nextIncrementHigh, nextIncrementLow, multiplierHigh, multiplierLow, incrementHigh, incrementLow);
+			incrementHigh = nextIncrementHigh;
+			incrementLow = nextIncrementLow;
+
+			std::uint64_t nextMultiplierHigh = multiplierHigh, nextMultiplierLow = multiplierLow;
+			MultiplyAdd(nextMultiplierHigh, nextMultiplierLow, multiplierHigh, multiplierLow, 0, 0);
+			multiplierHigh = nextMultiplierHigh;
+			multiplierLow = nextMultiplierLow;
+		}
+
+		MultiplyAdd(_stateHigh, _stateLow, accumulatedMultiplierHigh, accumulatedMultiplierLow,
+					accumulatedIncrementHigh, accumulatedIncrementLow);
+	}
+
+	friend constexpr bool operator==(const Pcg64& left, const Pcg64& right) noexcept = default;
+};
+
+/// <summary>
+/// The Philox4x32-10 function as pure free-standing code for CUDA, HIP, SYCL and OpenMP offload kernels:
+/// element index of a stream is computed from the key, the stream and the index alone, with no engine object.
+/// Element index is the lane index % 2 of the block number index / 2. Philox4x32 is built on these functions,
+/// so a device kernel given the seed of a Philox4x32 reproduces its At() and Fill() bit for bit,
+/// as well as the Fill of a PhiloxRandom from the stream and the index of its engine.
+/// </summary>
+#if defined(_OPENMP)
+	#pragma omp declare target
+#endif
+class PhiloxKernel
+{
+public:
+	static constexpr std::uint32_t Multiplier0 = 0xD2511F53;
+	static constexpr std::uint32_t Multiplier1 = 0xCD9E8D57;
+	static constexpr std::uint32_t Weyl0 = 0x9E3779B9;
+	static constexpr std::uint32_t Weyl1 = 0xBB67AE85;
+	static constexpr int Rounds = 10;
+
+	/// <summary>
+	/// Ten rounds over the counter (counter, stream)
+	/// </summary>
+	/// <param name="key"> - key, the seed</param>
+	/// <param name="stream"> - stream number</param>
+	/// <param name="counter"> - block number</param>
+	/// <param name="output"> - 128 bits of the block</param>
+	RANDOM_HOST_DEVICE static constexpr void Block(std::uint64_t key, std::uint64_t stream, std::uint64_t counter, std::uint32_t (&output)[4]) noexcept
+	{
+		std::uint32_t x0 = static_cast<std::uint32_t>(counter), x1 = static_cast<std::uint32_t>(counter >> 32);
+		std::uint32_t x2 = static_cast<std::uint32_t>(stream), x3 = static_cast<std::uint32_t>(stream >> 32);
+		std::uint32_t k0 = static_cast<std::uint32_t>(key), k1 = static_cast<std::uint32_t>(key >> 32);
+
+		RANDOM_UNROLL
+		for(int round = 0; round < Rounds; round++)
+		{
+			const std::uint64_t product0 = std::uint64_t(Multiplier0) * x0;
+			const std::uint64_t product1 = std::uint64_t(Multiplier1) * x2;
+
+			x0 = static_cast<std::uint32_t>(product1 >> 32) ^ x1 ^ k0;
+			x1 = static_cast<std::uint32_t>(product1);
+			x2 = static_cast<std::uint32_t>(product0 >> 32) ^ x3 ^ k1;
+			x3 = static_cast<std::uint32_t>(product0);
+			k0 += Weyl0;
+			k1 += Weyl1;
+		}
+
+		output[0] = x0;
+		output[1] = x1;
+		output[2] = x2;
+		output[3] = x3;
+	}
+
+	/// <summary>
+	/// 64 bits of a block
+	/// </summary>
+	/// <param name="block"> - block computed by Block</param>
+	/// <param name="lane"> - 0 or 1</param>
+	RANDOM_HOST_DEVICE static constexpr std::uint64_t Lane(const std::uint32_t (&block)[4], std::uint64_t lane) noexcept
+	{
+		const unsigned half = static_cast<unsigned>(lane & 1) * 2;
+		return block[half] | (std::uint64_t(block[half + 1]) << 32);
+	}
+
+	/// <summary>
+	/// Element of a stream
+	/// </summary>
+	/// <param name="key"> - key, the seed</param>
+	/// <param name="stream"> - stream number</param>
+	/// <param name="index"> - index of the element</param>
+	/// <returns>64 random bits</returns>
+	RANDOM_HOST_DEVICE static constexpr std::uint64_t Bits(std::uint64_t key, std::uint64_t stream, std::uint64_t index) noexcept
+	{
+		std::uint32_t block[4];
+
+		Block(key, stream, index >> 1, block);
+		return Lane(block, index);
+	}
+
+	/// <summary>
+	/// Map an element to a number as Philox4x32::Fill does: integers take the low bits, bools the high bit,
+	/// doubles are in a range [0, 1) with 53 bits, floats are in a range [0, 1) with the high 24 bits
+	/// </summary>
+	template<typename TValue>
+	RANDOM_HOST_DEVICE static constexpr TValue Convert(std::uint64_t bits) noexcept
+	{
+		if constexpr(std::is_same_v<TValue, bool>)
+		{
+			return (bits >> 63) != 0;
+		}
+		else if constexpr(std::is_same_v<TValue, float>)
+		{
+			return static_cast<float>(static_cast<std::uint32_t>(bits >> 32) >> 8) * 0x1.0p-24f;
+		}
+		else if constexpr(std::is_floating_point_v<TValue>)
+		{
+			return static_cast<TValue>(static_cast<double>(bits >> 11) * 0x1.0p-53);
+		}
+		else
+		{
+			return static_cast<TValue>(bits);
+		}
+	}
+
+	/// <summary>
+	/// Fill an array with the elements offset, offset + 1, ... of a stream.
+	/// A device thread may fill its own slice of a global array by passing its first index as the offset.
+	/// </summary>
+	/// <param name="output"> - array of numbers</param>
+	/// <param name="count"> - number of elements</param>
+	/// <param name="key"> - key, the seed</param>
+	/// <param name="stream"> - stream number</param>
+	/// <param name="offset"> - index of the first element</param>
+	template<typename TValue>
+	RANDOM_HOST_DEVICE static constexpr void Fill(TValue* output, std::uint64_t count, std::uint64_t key, std::uint64_t stream, std::uint64_t offset) noexcept
+	{
+		std::uint32_t block[4] = {};
+		std::uint64_t counter = offset >> 1;
+		std::uint64_t i = 0;
+
+		if((offset & 1) && count > 0)
+		{
+			Block(key, stream, counter++, block);
+			output[i++] = Convert<TValue>(Lane(block, 1));
+		}
+
+		// The blocks are independent, so their rounds overlap in the pipeline
+		for(; i + 2 <= count; i += 2)
+		{
+			Block(key, stream, counter++, block);
+			output[i] = Convert<TValue>(Lane(block, 0));
+			output[i + 1] = Convert<TValue>(Lane(block, 1));
+		}
+
+		if(i < count)
+		{
+			Block(key, stream, counter, block);
+			output[i] = Convert<TValue>(Lane(block, 0));
+		}
+	}
+};
+#if defined(_OPENMP)
+	#pragma omp end declare target
+#endif
+
+/// <summary>
+/// Philox4x32-10 counter-based engine by J. Salmon et al. (Random123). Element i of a stream is
+/// a pure function of the key, the stream and i, so any element is reached in O(1)
+/// and independent slices of one global stream need no coordination.
+/// Every 128-bit block gives two 64-bit elements.
+/// </summary>
+class Philox4x32
+{
+protected:
+	std::uint64_t _key = 0;
+	std::uint64_t _stream = 0;
+	std::uint64_t _index = 0; // index of the next element
+	std::uint32_t _block[4] = {};
+public:
+	using result_type = std::uint64_t;
+
+	constexpr Philox4x32() noexcept = default;
+
+	explicit constexpr Philox4x32(std::uint64_t value) noexcept:
+		_key(value)
+	{}
+
+	/// <summary>
+	/// Select one of 2^64 streams of 2^64 elements each
+	/// </summary>
+	/// <param name="value"> - seed value, the key</param>
+	/// <param name="stream"> - stream number</param>
+	constexpr Philox4x32(std::uint64_t value, std::uint64_t stream) noexcept:
+		_key(value),
+		_stream(stream)
+	{}
+
+	static constexpr result_type min() noexcept
+	{
+		return 0;
+	}
+
+	static constexpr result_type max() noexcept
+	{
+		return UINT64_MAX;
+	}
+
+	constexpr void seed(std::uint64_t value) noexcept
+	{
+		seed(value, 0);
+	}
+
+	constexpr void seed(std::uint64_t value, std::uint64_t stream) noexcept
+	{
+		_key = value;
+		_stream = stream;
+		_index = 0;
+	}
+
+	constexpr result_type operator()() noexcept
+	{
+		// The block is computed for an even index and kept for the odd one
+		if((_index & 1) == 0)
+		{
+			PhiloxKernel::Block(_key, _stream, _index >> 1, _block);
+		}
+
+		return PhiloxKernel::Lane(_block, _index++);
+	}
+
+	/// <summary>
+	/// Advance the engine by count elements in O(1) time
+	/// </summary>
+	/// <param name="count"> - number of elements</param>
+	constexpr void discard(unsigned long long count) noexcept
+	{
+		Seek(_stream, _index + count);
+	}
+
+	/// <summary>
+	/// Move the engine to an element of a stream in O(1) time
+	/// </summary>
+	/// <param name="stream"> - stream number</param>
+	/// <param name="index"> - index of the next element</param>
+	constexpr void Seek(std::uint64_t stream, std::uint64_t index) noexcept
+	{
+		_stream = stream;
+		_index = index;
+
+		if(_index & 1)
+		{
+			PhiloxKernel::Block(_key, _stream, _index >> 1, _block);
+		}
+	}
+
+	std::uint64_t Stream() const noexcept
+	{
+		return _stream;
+	}
+
+	std::uint64_t Index() const noexcept
+	{
+		return _index;
+	}
+
+	/// <summary>
+	/// Compute an element of a stream without changing the engine
+	/// </summary>
+	/// <param name="stream"> - stream number</param>
+	/// <param name="index"> - index of the element</param>
+	/// <returns>64 random bits</returns>
+	constexpr std::uint64_t At(std::uint64_t stream, std::uint64_t index) const noexcept
+	{
+		return PhiloxKernel::Bits(_key, stream, index);
+	}
+
+	/// <summary>
+	/// Fill a numeric range with the elements of the current stream starting from offset,
+	/// without changing the engine. Integers take the low bits of the elements, bools the high bit,
+	/// real numbers are in a range [0, 1) like NextDouble and NextFloat.
+	/// </summary>
+	/// <param name="range"> - numeric range</param>
+	/// <param name="offset"> - index of the first element</param>
+	template<typename TRange> requires IsArithmeticRange<TRange>
+	constexpr void Fill(TRange&& range, std::uint64_t offset) const noexcept
+	{
+		using TValue = std::ranges::range_value_t<TRange>;
+
+		if constexpr(std::ranges::contiguous_range<TRange> && std::ranges::sized_range<TRange>)
+		{
+			if(!std::is_constant_evaluated())
+			{
+				PhiloxKernel::Fill(std::ranges::data(range), std::ranges::size(range), _key, _stream, offset);
+				return;
+			}
+		}
+
+		std::uint64_t index = offset;
+
+		for(auto&& item : range)
+		{
+			item = PhiloxKernel::Convert<TValue>(PhiloxKernel::Bits(_key, _stream, index++));
+		}
+	}
+
+	friend constexpr bool operator==(const Philox4x32& left, const Philox4x32& right) noexcept
+	{
+		return left._key == right._key && left._stream == right._stream && left._index == right._index;
+	}
+};
+
+/// <summary>
+/// Eight interleaved xoshiro256++ engines for bulk generation. The state is stored
+/// lane by lane, so every step maps onto SIMD instructions: one AVX-512 or two AVX2 registers
+/// per state word on x86, four NEON registers on ARM. On x86 the AVX2 or AVX-512 kernel is
+/// selected at runtime by the CPU features. Fill uses it for contiguous ranges
+/// of reals and 32-bit integers.
+/// </summary>
+class Xoshiro256PlusPlusX8
+{
+	friend class ThreadLocalEngine;
+public:
+	static constexpr std::size_t Lanes = 8;
+
+	/// <summary>
+	/// The range size starting from which the bulk kernels beat a scalar engine
+	/// </summary>
+	static constexpr std::size_t MinBulkSize = 64;
+protected:
+	enum class SimdLevel
+	{
+		Default,
+		Avx2,
+		Avx512
+	};
+
+	alignas(64) std::uint64_t _state[4][Lanes];
+
+	/// <summary>
+	/// 32-bit halves of one step kept for the redraws of the bounded kernel, so one step serves 16 redraws
+	/// </summary>
+	struct SpareWords
+	{
+		std::uint32_t Words[2 * Lanes];
+		std::size_t Position = 2 * Lanes;
+	};
+
+	static SimdLevel DetectSimdLevel() noexcept
+	{
+	#if defined(RANDOM_X86_DISPATCH)
+		static const SimdLevel level = __builtin_cpu_supports("avx512f") ? SimdLevel::Avx512 :
+									   __builtin_cpu_supports("avx2") ? SimdLevel::Avx2 :
+									   SimdLevel::Default;
+		return level;
+	#else
+		return SimdLevel::Default;
+	#endif
+	}
+
+#if defined(RANDOM_VECTOR_EXTENSIONS)
+	// The vector helpers are always inlined, so they never cross an ABI boundary
+	#pragma GCC diagnostic push
+	#pragma GCC diagnostic ignored "-Wpsabi"
+
+	typedef std::uint64_t Vector __attribute__((vector_size(8 * Lanes)));
+	typedef double RealVector __attribute__((vector_size(8 * Lanes)));
+	typedef float FloatVector __attribute__((vector_size(4 * Lanes)));
+	typedef std::uint32_t HalfVector __attribute__((vector_size(4 * Lanes)));
+
+	static RANDOM_ALWAYS_INLINE void Step(Vector (&state)[4], Vector& output) noexcept
+	{
+		const Vector sum = state[0] + state[3];
+		const Vector t = state[1] << 17;
+
+		output = ((sum << 23) | (sum >> 41)) + state[0];
+
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= t;
+		state[3] = (state[3] << 45) | (state[3] >> 19);
+	}
+
+	/// <summary>
+	/// Store min + (bits >> 11) * 2^-53 * scale, or (bits >> 40) * 2^-24 for floats, clamped to bound.
+	/// Avoids an integer to double conversion, which AVX2 lacks: the upper 52 bits form
+	/// the mantissa of a double in [1, 2) and the 53rd bit is added exactly.
+	/// </summary>
+	template<typename TReal>
+	static RANDOM_ALWAYS_INLINE void Store(TReal* output, const Vector& bits, double min, double scale, TReal bound, std::size_t count) noexcept
+	{
+		RealVector unit;
+
+		if constexpr(std::is_same_v<TReal, float>)
+		{
+			unit = (RealVector)(((bits >> 40) << 28) | 0x3ff0000000000000) - 1.0;
+		}
+		else
+		{
+			const Vector half = -((bits >> 11) & 1) & 0x3ca0000000000000;
+			unit = (RealVector)((bits >> 12) | 0x3ff0000000000000) - 1.0 + (RealVector)half;
+		}
+
+		const RealVector values = min + unit * scale;
+
+		if constexpr(std::is_same_v<TReal, double>)
+		{
+			const RealVector bounds = RealVector{} + bound;
+			const RealVector clamped = values < bounds ? values : bounds;
+			std::memcpy(output, &clamped, count * sizeof(double));
+		}
+		else if constexpr(std::is_same_v<TReal, float>)
+		{
+			const FloatVector floats = __builtin_convertvector(values, FloatVector);
+			const FloatVector bounds = FloatVector{} + bound;
+			const FloatVector clamped = floats < bounds ? floats : bounds;
+			std::memcpy(output, &clamped, count * sizeof(float));
+		}
+		else
+		{
+			for(std::size_t lane = 0; lane < count; lane++)
+			{
+				output[lane] = std::min(static_cast<TReal>(values[lane]), bound);
+			}
+		}
+	}
+
+	template<typename TInt>
+	static RANDOM_ALWAYS_INLINE void Store(TInt* output, const HalfVector (&values)[2], std::size_t count) noexcept
+	{
+		if(count >= 2 * Lanes) [[likely]]
+		{
+			std::memcpy(output, values, sizeof(values));
+		}
+		else
+		{
+			std::memcpy(output, values, count * sizeof(TInt));
+		}
+	}
+
+	template<typename TReal>
+	RANDOM_ALWAYS_INLINE void FillRealsKernel(TReal* output, std::size_t count, double min, double max) noexcept
+	{
+		Vector state[4];
+		Vector bits;
+		const double scale = max - min;
+		const TReal bound = RandomBits::UpperBound(static_cast<TReal>(min), static_cast<TReal>(max));
+		std::size_t i = 0;
+
+		std::memcpy(state, _state, sizeof(state));
+
+		for(; i + Lanes <= count; i += Lanes)
+		{
+			Step(state, bits);
+			Store(output + i, bits, min, scale, bound, Lanes);
+		}
+
+		if(i < count)
+		{
+			Step(state, bits);
+			Store(output + i, bits, min, scale, bound, count - i);
+		}
+
+		std::memcpy(_state, state, sizeof(state));
+	}
+
+	RANDOM_ALWAYS_INLINE void FillBytesKernel(std::byte* output, std::size_t size) noexcept
+	{
+		Vector state[4];
+		Vector bits;
+		std::size_t i = 0;
+
+		std::memcpy(state, _state, sizeof(state));
+
+		for(; i + sizeof(bits) <= size; i += sizeof(bits))
+		{
+			Step(state, bits);
+			std::memcpy(output + i, &bits, sizeof(bits));
+		}
+
+		if(i < size)
+		{
+			Step(state, bits);
+			std::memcpy(output + i, &bits, size - i);
+		}
+
+		std::memcpy(_state, state, sizeof(state));
+	}
+
+	/// <summary>
+	/// Lemire's multiply-shift on the both 32-bit halves of every output.
+	/// Products whose low half falls under the threshold are redrawn one by one from the spare halves of a step.
+	/// </summary>
+	template<typename TInt>
+	RANDOM_ALWAYS_INLINE void FillIntsKernel(TInt* output, std::size_t count, std::uint32_t min, std::uint64_t range) noexcept
+	{
+		Vector state[4];
+		Vector bits;
+		HalfVector values[2];
+		SpareWords spare;
+		std::size_t i = 0;
+
+		std::memcpy(state, _state, sizeof(state));
+
+		if(range > UINT32_MAX)
+		{
+			for(; i < count; i += 2 * Lanes)
+			{
+				Step(state, bits);
+
+				values[0] = __builtin_convertvector(bits >> 32, HalfVector) + min;
+				values[1] = __builtin_convertvector(bits & UINT32_MAX, HalfVector) + min;
+				Store(output + i, values, count - i);
+			}
+		}
+		else
+		{
+			const std::uint32_t threshold = static_cast<std::uint32_t>((std::uint64_t(1) << 32) % range);
+			const Vector multiplier = __builtin_convertvector(HalfVector{} + static_cast<std::uint32_t>(range), Vector);
+
+			for(; i < count; i += 2 * Lanes)
+			{
+				Step(state, bits);
+
+				const Vector high = (bits >> 32) * multiplier;
+				const Vector low = (bits & UINT32_MAX) * multiplier;
+				const Vector rejected = (Vector)((high & UINT32_MAX) < threshold) | (Vector)((low & UINT32_MAX) < threshold);
+				std::uint64_t anyRejected = 0;
+
+				values[0] = __builtin_convertvector(high >> 32, HalfVector) + min;
+				values[1] = __builtin_convertvector(low >> 32, HalfVector) + min;
+
+				for(std::size_t lane = 0; lane < Lanes; lane++)
+				{
+					anyRejected |= rejected[lane];
+				}
+
+				if(anyRejected) [[unlikely]]
+				{
+					for(std::size_t lane = 0; lane < Lanes; lane++)
+					{
+						values[0][lane] = min + Redraw(state, spare, high[lane], range, threshold);
+						values[1][lane] = min + Redraw(state, spare, low[lane], range, threshold);
+					}
+				}
+
+				Store(output + i, values, count - i);
+			}
+		}
+
+		std::memcpy(_state, state, sizeof(state));
+	}
+
+	static RANDOM_ALWAYS_INLINE std::uint32_t Redraw(Vector (&state)[4], SpareWords& spare, std::uint64_t product, std::uint64_t range,
+													 std::uint32_t threshold) noexcept
+	{
+		while(static_cast<std::uint32_t>(product) < threshold)
+		{
+			if(spare.Position == 2 * Lanes)
+			{
+				Vector bits;
+
+				Step(state, bits);
+
+				for(std::size_t lane = 0; lane < Lanes; lane++)
+				{
+					spare.Words[lane] = static_cast<std::uint32_t>(bits[lane] >> 32);
+					spare.Words[Lanes + lane] = static_cast<std::uint32_t>(bits[lane]);
+				}
+
+				spare.Position = 0;
+			}
+
+			product = std::uint64_t(spare.Words[spare.Position++]) * range;
+		}
+
+		return static_cast<std::uint32_t>(product >> 32);
+	}
+
+	#pragma GCC diagnostic pop
+#else
+	static RANDOM_ALWAYS_INLINE void Step(std::uint64_t (&state)[4][Lanes], std::uint64_t (&output)[Lanes]) noexcept
+	{
+		for(std::size_t lane = 0; lane < Lanes; lane++)
+		{
+			const std::uint64_t sum = state[0][lane] + state[3][lane];
+			const std::uint64_t t = state[1][lane] << 17;
+
+			output[lane] = ((sum << 23) | (sum >> 41)) + state[0][lane];
+
+			state[2][lane] ^= state[0][lane];
+			state[3][lane] ^= state[1][lane];
+			state[1][lane] ^= state[2][lane];
+			state[0][lane] ^= state[3][lane];
+			state[2][lane] ^= t;
+			state[3][lane] = (state[3][lane] << 45) | (state[3][lane] >> 19);
+		}
+	}
+
+	/// <summary>
+	/// (bits >> 11) * 2^-53 without an integer to double conversion, which AVX2 lacks:
+	/// the upper 52 bits form the mantissa of a double in [1, 2) and the 53rd bit is added exactly
+	/// </summary>
+	template<typename TReal>
+	static RANDOM_ALWAYS_INLINE double ToUnit(std::uint64_t bits) noexcept
+	{
+		if constexpr(std::is_same_v<TReal, float>)
+		{
+			return std::bit_cast<double>(((bits >> 40) << 28) | 0x3ff0000000000000) - 1.0;
+		}
+		else
+		{
+			const double unit = std::bit_cast<double>((bits >> 12) | 0x3ff0000000000000) - 1.0;
+			return unit + ((bits & 0x800) ? 0x1.0p-53 : 0.0);
+		}
+	}
+
+	template<typename TReal>
+	RANDOM_ALWAYS_INLINE void FillRealsKernel(TReal* output, std::size_t count, double min, double max) noexcept
+	{
+		alignas(64) std::uint64_t state[4][Lanes];
+		alignas(64) std::uint64_t bits[Lanes];
+		const double scale = max - min;
+		const TReal bound = RandomBits::UpperBound(static_cast<TReal>(min), static_cast<TReal>(max));
+		std::size_t i = 0;
+
+		std::copy(&_state[0][0], &_state[0][0] + 4 * Lanes, &state[0][0]);
+
+		for(; i + Lanes <= count; i += Lanes)
+		{
+			Step(state, bits);
+
+			for(std::size_t lane = 0; lane < Lanes; lane++)
+			{
+				output[i + lane] = std::min(static_cast<TReal>(min + ToUnit<TReal>(bits[lane]) * scale), bound);
+			}
+		}
+
+		if(i < count)
+		{
+			Step(state, bits);
+
+			for(std::size_t lane = 0; i < count; i++, lane++)
+			{
+				output[i] = std::min(static_cast<TReal>(min + ToUnit<TReal>(bits[lane]) * scale), bound);
+			}
+		}
+
+		std::copy(&state[0][0], &state[0][0] + 4 * Lanes, &_state[0][0]);
+	}
+
+	RANDOM_ALWAYS_INLINE void FillBytesKernel(std::byte* output, std::size_t size) noexcept
+	{
+		alignas(64) std::uint64_t state[4][Lanes];
+		alignas(64) std::uint64_t bits[Lanes];
+		std::size_t i = 0;
+
+		std::copy(&_state[0][0], &_state[0][0] + 4 * Lanes, &state[0][0]);
+
+		for(; i < size; i += sizeof(bits))
+		{
+			Step(state, bits);
+			std::memcpy(output + i, bits, std::min(sizeof(bits), size - i));
+		}
+
+		std::copy(&state[0][0], &state[0][0] + 4 * Lanes, &_state[0][0]);
+	}
+
+	/// <summary>
+	/// Lemire's multiply-shift on the both 32-bit halves of every output.
+	/// Products whose low half falls under the threshold are redrawn one by one from the spare halves of a step.
+	/// </summary>
+	template<typename TInt>
+	RANDOM_ALWAYS_INLINE void FillIntsKernel(TInt* output, std::size_t count, std::uint32_t min, std::uint64_t range) noexcept
+	{
+		alignas(64) std::uint64_t state[4][Lanes];
+		alignas(64) std::uint64_t bits[Lanes];
+		alignas(64) std::uint32_t values[2 * Lanes];
+		const std::uint32_t threshold = static_cast<std::uint32_t>((std::uint64_t(1) << 32) % range);
+		const std::uint64_t multiplier = range;
+		SpareWords spare;
+		std::size_t i = 0;
+
+		std::copy(&_state[0][0], &_state[0][0] + 4 * Lanes, &state[0][0]);
+
+		while(i < count)
+		{
+			bool rejected = false;
+
+			Step(state, bits);
+
+			for(std::size_t lane = 0; lane < Lanes; lane++)
+			{
+				const std::uint64_t high = (bits[lane] >> 32) * multiplier;
+				const std::uint64_t low = (bits[lane] & UINT32_MAX) * multiplier;
+
+				values[lane] = static_cast<std::uint32_t>(high >> 32);
+				values[Lanes + lane] = static_cast<std::uint32_t>(low >> 32);
+				rejected |= static_cast<std::uint32_t>(high) < threshold;
+				rejected |= static_cast<std::uint32_t>(low) < threshold;
+			}
+
+			if(rejected) [[unlikely]]
+			{
+				// Recompute the block and redraw the biased values one by one
+				for(std::size_t lane = 0; lane < Lanes; lane++)
+				{
+					values[lane] = Redraw(state, spare, bits[lane] >> 32, multiplier, threshold);
+					values[Lanes + lane] = Redraw(state, spare, bits[lane] & UINT32_MAX, multiplier, threshold);
+				}
+			}
+
+			for(std::size_t j = 0; j < 2 * Lanes && i < count; j++, i++)
+			{
+				output[i] = static_cast<TInt>(min + values[j]);
+			}
+		}
+
+		std::copy(&state[0][0], &state[0][0] + 4 * Lanes, &_state[0][0]);
+	}
+
+	static std::uint32_t Redraw(std::uint64_t (&state)[4][Lanes], SpareWords& spare, std::uint64_t value,
+								std::uint64_t multiplier, std::uint32_t threshold) noexcept
+	{
+		std::uint64_t product = value * multiplier;
+
+		while(static_cast<std::uint32_t>(product) < threshold)
+		{
+			if(spare.Position == 2 * Lanes)
+			{
+				std::uint64_t bits[Lanes];
+
+				Step(state, bits);
+
+				for(std::size_t lane = 0; lane < Lanes; lane++)
+				{
+					spare.Words[lane] = static_cast<std::uint32_t>(bits[lane] >> 32);
+					spare.Words[Lanes + lane] = static_cast<std::uint32_t>(bits[lane]);
+				}
+
+				spare.Position = 0;
+			}
+
+			product = spare.Words[spare.Position++] * multiplier;
+		}
+
+		return static_cast<std::uint32_t>(product >> 32);
+	}
+#endif
+
+	template<typename TReal>
+	void FillRealsDefault(TReal* output, std::size_t count, double min, double max) noexcept
+	{
+		FillRealsKernel(output, count, min, max);
+	}
+
+	template<typename TInt>
+	void FillIntsDefault(TInt* output, std::size_t count, std::uint32_t min, std::uint64_t range) noexcept
+	{
+		FillIntsKernel(output, count, min, range);
+	}
+
+	void FillBytesDefault(std::byte* output, std::size_t size) noexcept
+	{
+		FillBytesKernel(output, size);
+	}
+
+#if defined(RANDOM_X86_DISPATCH)
+	template<typename TReal>
+	RANDOM_TARGET("avx2") void FillRealsAvx2(TReal* output, std::size_t count, double min, double max) noexcept
+	{
+		FillRealsKernel(output, count, min, max);
+	}
+
+	template<typename TInt>
+	RANDOM_TARGET("avx2") void FillIntsAvx2(TInt* output, std::size_t count, std::uint32_t min, std::uint64_t range) noexcept
+	{
+		FillIntsKernel(output, count, min, range);
+	}
+
+	RANDOM_TARGET("avx2") void FillBytesAvx2(std::byte* output, std::size_t size) noexcept
+	{
+		FillBytesKernel(output, size);
+	}
+
+	template<typename TReal>
+	RANDOM_TARGET("avx512f") void FillRealsAvx512(TReal* output, std::size_t count, double min, double max) noexcept
+	{
+		FillRealsKernel(output, count, min, max);
+	}
+
+	template<typename TInt>
+	RANDOM_TARGET("avx512f") void FillIntsAvx512(TInt* output, std::size_t count, std::uint32_t min, std::uint64_t range) noexcept
+	{
+		FillIntsKernel(output, count, min, range);
+	}
+
+	RANDOM_TARGET("avx512f") void FillBytesAvx512(std::byte* output, std::size_t size) noexcept
+	{
+		FillBytesKernel(output, size);
+	}
+#endif
+
+	/// <summary>
+	/// Leave the lanes unseeded, zero in a thread_local object, which is then constant-initialized
+	/// </summary>
+	Xoshiro256PlusPlusX8() noexcept = default;
+public:
+	/// <summary>
+	/// Seed the lanes with consecutive outputs of SplitMix64
+	/// </summary>
+	/// <param name="value"> - seed value</param>
+	explicit Xoshiro256PlusPlusX8(std::uint64_t value) noexcept
+	{
+		SplitMix64 expander(value);
+
+		for(std::size_t lane = 0; lane < Lanes; lane++)
+		{
+			for(auto& word : _state)
+			{
+				word[lane] = expander();
+			}
+		}
+	}
+
+	/// <summary>
+	/// Start lane k from the base stream advanced by k calls of jump(), so the lanes are
+	/// consecutive 2^128-long subsequences of the base stream and never overlap each other
+	/// </summary>
+	/// <param name="base"> - base stream</param>
+	explicit Xoshiro256PlusPlusX8(Xoshiro256PlusPlus base) noexcept
+	{
+		for(std::size_t lane = 0; lane < Lanes; lane++)
+		{
+			for(std::size_t i = 0; i < 4; i++)
+			{
+				_state[i][lane] = base._state[i];
+			}
+
+			base.jump();
+		}
+	}
+
+	/// <summary>
+	/// Fill an array with random real numbers in a range [min, max).
+	/// Floats take 24 random bits, so in a range [0, 1) they never round up to 1.
+	/// </summary>
+	/// <param name="output"> - array of double or float</param>
+	/// <param name="count"> - number of elements</param>
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	template<typename TReal> requires std::is_floating_point_v<TReal>
+	void FillReals(TReal* output, std::size_t count, double min, double max) noexcept
+	{
+		switch(DetectSimdLevel())
+		{
+		#if defined(RANDOM_X86_DISPATCH)
+			case SimdLevel::Avx512:
+				FillRealsAvx512(output, count, min, max);
+				break;
+			case SimdLevel::Avx2:
+				FillRealsAvx2(output, count, min, max);
+				break;
+		#endif
+			default:
+				FillRealsDefault(output, count, min, max);
+				break;
+		}
+	}
+
+	/// <summary>
+	/// Fill an array of 32-bit integers with unbiased random numbers in a range [min, max]
+	/// </summary>
+	/// <param name="output"> - array of 32-bit integers</param>
+	/// <param name="count"> - number of elements</param>
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	template<typename TInt> requires std::is_integral_v<TInt> && (sizeof(TInt) == 4)
+	void FillInts(TInt* output, std::size_t count, TInt min, TInt max) noexcept
+	{
+		const std::uint64_t range = std::uint64_t(static_cast<std::uint32_t>(max) - static_cast<std::uint32_t>(min)) + 1;
+		const std::uint32_t offset = static_cast<std::uint32_t>(min);
+
+		switch(DetectSimdLevel())
+		{
+		#if defined(RANDOM_X86_DISPATCH)
+			case SimdLevel::Avx512:
+				FillIntsAvx512(output, count, offset, range);
+				break;
+			case SimdLevel::Avx2:
+				FillIntsAvx2(output, count, offset, range);
+				break;
+		#endif
+			default:
+				FillIntsDefault(output, count, offset, range);
+				break;
+		}
+	}
+
+	/// <summary>
+	/// Fill memory with raw outputs, lane by lane
+	/// </summary>
+	/// <param name="output"> - memory, need not be aligned</param>
+	/// <param name="size"> - number of bytes</param>
+	void FillBytes(std::byte* output, std::size_t size) noexcept
+	{
+		switch(DetectSimdLevel())
+		{
+		#if defined(RANDOM_X86_DISPATCH)
+			case SimdLevel::Avx512:
+				FillBytesAvx512(output, size);
+				break;
+			case SimdLevel::Avx2:
+				FillBytesAvx2(output, size);
+				break;
+		#endif
+			default:
+				FillBytesDefault(output, size);
+				break;
+		}
+	}
+
+	/// <summary>
+	/// Fill an array with raw 64-bit outputs, lane by lane
+	/// </summary>
+	/// <param name="output"> - array of 64-bit words</param>
+	/// <param name="count"> - number of elements</param>
+	void FillBits(std::uint64_t* output, std::size_t count) noexcept
+	{
+		FillBytes(reinterpret_cast<std::byte*>(output), count * sizeof(std::uint64_t));
+	}
+};
+
+/// <summary>
+/// Unbiased random integers in a range [min, max] by D. Lemire's nearly divisionless method:
+/// a multiplication and a shift per value, a division only on the rare rejection path.
+/// The sampler precomputes the range and the rejection threshold, so it suits loops
+/// drawing from the same range many times.
+/// </summary>
+template<typename TInt> requires std::is_integral_v<TInt> && (!std::is_same_v<TInt, bool>)
+class BoundedSampler
+{
+protected:
+	using TUnsigned = std::conditional_t<(sizeof(TInt) <= 4), std::uint32_t, std::uint64_t>;
+
+	TUnsigned _min;
+	TUnsigned _range; // 0 stands for the full range of TUnsigned
+	TUnsigned _threshold;
+
+	template<typename TGenerator>
+	static constexpr TUnsigned NextBits(TGenerator& generator) noexcept
+	{
+		if constexpr(sizeof(TUnsigned) == 4)
+		{
+			return RandomBits::Next32(generator);
+		}
+		else
+		{
+			return RandomBits::Next64(generator);
+		}
+	}
+
+	/// <summary>
+	/// The high and the low halves of bits * range
+	/// </summary>
+	static constexpr void Multiply(TUnsigned bits, TUnsigned range, TUnsigned& high, TUnsigned& low) noexcept
+	{
+		if constexpr(sizeof(TUnsigned) == 4)
+		{
+			const std::uint64_t product = std::uint64_t(bits) * range;
+			high = static_cast<TUnsigned>(product >> 32);
+			low = static_cast<TUnsigned>(product);
+		}
+		else
+		{
+			high = RandomBits::MultiplyHigh(bits, range);
+			low = bits * range;
+		}
+	}
+
+	template<typename TGenerator>
+	static constexpr TUnsigned Sample(TGenerator& generator, TUnsigned range, TUnsigned threshold) noexcept
+	{
+		TUnsigned high, low;
+
+		Multiply(NextBits(generator), range, high, low);
+
+		while(low < threshold)
+		{
+			RandomStatistics::CountRejection();
+			Multiply(NextBits(generator), range, high, low);
+		}
+
+		return high;
+	}
+public:
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	constexpr BoundedSampler(TInt min, TInt max) noexcept:
+		_min(static_cast<TUnsigned>(min)),
+		_range(static_cast<TUnsigned>(static_cast<TUnsigned>(max) - static_cast<TUnsigned>(min) + 1)),
+		_threshold(_range == 0 ? 0 : static_cast<TUnsigned>(static_cast<TUnsigned>(-_range) % _range))
+	{}
+
+	constexpr TInt Min() const noexcept
+	{
+		return static_cast<TInt>(_min);
+	}
+
+	constexpr TInt Max() const noexcept
+	{
+		return static_cast<TInt>(_min + _range - 1);
+	}
+
+	/// <summary>
+	/// Generate a random number in a range [Min(), Max()]
+	/// </summary>
+	/// <param name="generator"> - random bit generator</param>
+	/// <returns>a random number in a range [Min(), Max()]</returns>
+	template<typename TGenerator> requires std::uniform_random_bit_generator<TGenerator>
+	constexpr TInt operator()(TGenerator& generator) const noexcept
+	{
+		if(_range == 0)
+		{
+			return static_cast<TInt>(NextBits(generator));
+		}
+
+		return static_cast<TInt>(_min + Sample(generator, _range, _threshold));
+	}
+
+	/// <summary>
+	/// Generate a random number in a range [min, max] without a sampler.
+	/// The threshold is computed only when the first product may be biased.
+	/// </summary>
+	/// <param name="generator"> - random bit generator</param>
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	/// <returns>a random number in a range [min, max]</returns>
+	template<typename TGenerator> requires std::uniform_random_bit_generator<TGenerator>
+	static constexpr TInt Next(TGenerator& generator, TInt min, TInt max) noexcept
+	{
+		const TUnsigned range = static_cast<TUnsigned>(static_cast<TUnsigned>(max) - static_cast<TUnsigned>(min) + 1);
+		TUnsigned high, low;
+
+		if(range == 0)
+		{
+			return static_cast<TInt>(NextBits(generator));
+		}
+
+		Multiply(NextBits(generator), range, high, low);
+
+		if(low < range) [[unlikely]]
+		{
+			const TUnsigned threshold = static_cast<TUnsigned>(static_cast<TUnsigned>(-range) % range);
+
+			while(low < threshold)
+			{
+				RandomStatistics::CountRejection();
+				Multiply(NextBits(generator), range, high, low);
+			}
+		}
+
+		return static_cast<TInt>(static_cast<TUnsigned>(min) + high);
+	}
+};
+
+/// <summary>
+/// Fills a range with values of its own element type. Small types share engine outputs:
+/// a 64-bit output gives 8 bytes, 4 shorts or 2 ints and floats. Bounds that are not
+/// a power of two take lanes twice as wide as the element, so the rejections of Lemire's method stay rare.
+/// </summary>
+class PackedFiller
+{
+	template<typename TLane, typename TValue, typename TRange, typename TGenerator>
+	static constexpr void FillLanes(TRange& range, TValue min, std::uint64_t size, TGenerator& generator) noexcept
+	{
+		using TUnsigned = std::make_unsigned_t<TValue>;
+		using TProduct = std::conditional_t<(sizeof(TLane) == 4), std::uint64_t, std::uint32_t>;
+		constexpr int LaneBits = 8 * sizeof(TLane);
+		constexpr int LaneCount = 64 / LaneBits;
+
+		const TLane threshold = static_cast<TLane>(((TProduct(1) << LaneBits) - size) % size);
+		auto current = std::ranges::begin(range);
+		const auto last = std::ranges::end(range);
+
+		if constexpr(std::ranges::random_access_range<TRange> && std::ranges::sized_range<TRange>)
+		{
+			// Every lane writes, a rejected one is overwritten by the next lane
+			while(last - current > LaneCount)
+			{
+				std::uint64_t bits = RandomBits::Next64(generator);
+
+				RANDOM_UNROLL
+				for(int lane = 0; lane < LaneCount; lane++)
+				{
+					const TProduct product = TProduct(static_cast<TLane>(bits)) * static_cast<TProduct>(size);
+
+					const bool accepted = static_cast<TLane>(product) >= threshold;
+
+					*current = static_cast<TValue>(static_cast<TUnsigned>(static_cast<TUnsigned>(min) + static_cast<TUnsigned>(product >> LaneBits)));
+					current += accepted;
+					bits >>= LaneBits;
+
+					if constexpr(RandomStatistics::Enabled)
+					{
+						if(!accepted)
+						{
+							RandomStatistics::CountRejection();
+						}
+					}
+				}
+			}
+		}
+
+		while(current != last)
+		{
+			std::uint64_t bits = RandomBits::Next64(generator);
+
+			for(int lane = 0; lane < LaneCount && current != last; lane++)
+			{
+				const TProduct product = TProduct(static_cast<TLane>(bits)) * static_cast<TProduct>(size);
+
+				bits >>= LaneBits;
+
+				if(static_cast<TLane>(product) >= threshold) [[likely]]
+				{
+					*current = static_cast<TValue>(static_cast<TUnsigned>(static_cast<TUnsigned>(min) + static_cast<TUnsigned>(product >> LaneBits)));
+					++current;
+				}
+				else
+				{
+					RandomStatistics::CountRejection();
+				}
+			}
+		}
+	}
+
+	template<typename TValue, typename TRange, typename TGenerator>
+	static constexpr void FillRaw(TRange& range, TGenerator& generator) noexcept
+	{
+		constexpr int LaneBits = 8 * sizeof(TValue);
+		std::uint64_t bits = 0;
+		int available = 0;
+
+		for(auto& item : range)
+		{
+			if(available == 0)
+			{
+				bits = RandomBits::Next64(generator);
+				available = 64 / LaneBits;
+			}
+
+			item = static_cast<TValue>(bits);
+			bits >>= LaneBits;
+			available--;
+		}
+	}
+public:
+	/// <summary>
+	/// Fill a range with random numbers of its element type: integers in a range [min, max],
+	/// real numbers in a range [min, max)
+	/// </summary>
+	/// <param name="range"> - numeric range</param>
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	/// <param name="generator"> - random bit generator</param>
+	template<typename TRange, typename TGenerator> requires IsArithmeticRange<TRange>
+	static constexpr void Fill(TRange& range, std::ranges::range_value_t<TRange> min, std::ranges::range_value_t<TRange> max,
+							   TGenerator& generator) noexcept
+	{
+		using TValue = std::ranges::range_value_t<TRange>;
+
+		if constexpr(std::is_same_v<TValue, bool>)
+		{
+			std::uint64_t bits = 0;
+			int available = 0;
+
+			for(auto&& item : range)
+			{
+				if(available == 0)
+				{
+					bits = RandomBits::Next64(generator);
+					available = 64;
+				}
+
+				item = min == max ? min : static_cast<bool>(bits & 1);
+				bits >>= 1;
+				available--;
+			}
+		}
+		else if constexpr(std::is_integral_v<TValue> && sizeof(TValue) <= 4)
+		{
+			using TUnsigned = std::make_unsigned_t<TValue>;
+			using TWide = std::conditional_t<(sizeof(TValue) == 1), std::uint16_t, std::uint32_t>;
+
+			const std::uint64_t size = std::uint64_t(static_cast<TUnsigned>(static_cast<TUnsigned>(max) - static_cast<TUnsigned>(min))) + 1;
+
+			if(size == (std::uint64_t(1) << (8 * sizeof(TValue))))
+			{
+				FillRaw<TValue>(range, generator);
+			}
+			else if(std::has_single_bit(size) || sizeof(TValue) == 4)
+			{
+				FillLanes<TUnsigned>(range, min, size, generator);
+			}
+			else
+			{
+				FillLanes<TWide>(range, min, size, generator);
+			}
+		}
+		else if constexpr(std::is_integral_v<TValue>)
+		{
+			const BoundedSampler<TValue> sampler(min, max);
+
+			for(auto& item : range)
+			{
+				item = sampler(generator);
+			}
+		}
+		else if constexpr(std::is_same_v<TValue, float>)
+		{
+			const float scale = max - min;
+			const float bound = RandomBits::UpperBound(min, max);
+			std::uint64_t bits = 0;
+			bool available = false;
+
+			for(auto& item : range)
+			{
+				if(!available)
+				{
+					bits = RandomBits::Next64(generator);
+				}
+
+				item = std::min(min + scale * RandomBits::ToFloat(static_cast<std::uint32_t>(available ? bits : bits >> 32)), bound);
+				available = !available;
+			}
+		}
+		else
+		{
+			const TValue scale = max - min;
+			const TValue bound = RandomBits::UpperBound(min, max);
+
+			for(auto& item : range)
+			{
+				item = std::min(min + scale * static_cast<TValue>(RandomBits::ToDouble(RandomBits::Next64(generator))), bound);
+			}
+		}
+	}
+
+	/// <summary>
+	/// Fill a range with random numbers in a range [0, 1). Floats take 24 random bits,
+	/// two per output, so they never round up to 1.
+	/// </summary>
+	/// <param name="range"> - numeric range</param>
+	/// <param name="generator"> - random bit generator</param>
+	template<typename TRange, typename TGenerator> requires IsArithmeticRange<TRange>
+	static constexpr void FillUnit(TRange& range, TGenerator& generator) noexcept
+	{
+		using TValue = std::ranges::range_value_t<TRange>;
+
+		if constexpr(std::is_same_v<TValue, float>)
+		{
+			Fill(range, 0.0f, 1.0f, generator);
+		}
+		else
+		{
+			for(auto& item : range)
+			{
+				item = static_cast<TValue>(RandomBits::ToDouble(RandomBits::Next64(generator)));
+			}
+		}
+	}
+};
+
+/// <summary>
+/// Fills characters from an alphabet, several characters per 64-bit output. The characters of
+/// an alphabet of 2^b characters are b-bit fields of the output, other alphabets take 16-bit lanes
+/// by Lemire's method, the rejections of which are rare.
+/// </summary>
+class CharFiller
+{
+	template<int Bits, typename TGenerator>
+	static void FillFields(char* output, std::size_t size, const char* alphabet, TGenerator& generator) noexcept
+	{
+		constexpr int FieldCount = 64 / Bits;
+		constexpr std::uint64_t Mask = (std::uint64_t(1) << Bits) - 1;
+		std::size_t i = 0;
+
+		for(; i + FieldCount <= size; i += FieldCount)
+		{
+			const std::uint64_t bits = RandomBits::Next64(generator);
+
+			RANDOM_UNROLL
+			for(int field = 0; field < FieldCount; field++)
+			{
+				output[i + field] = alphabet[(bits >> (field * Bits)) & Mask];
+			}
+		}
+
+		if(i < size)
+		{
+			std::uint64_t bits = RandomBits::Next64(generator);
+
+			for(; i < size; i++, bits >>= Bits)
+			{
+				output[i] = alphabet[bits & Mask];
+			}
+		}
+	}
+public:
+	static constexpr std::string_view HexDigits = "0123456789abcdef";
+	static constexpr std::string_view Base64UrlDigits = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+	/// <summary>
+	/// Fill a buffer with random characters of an alphabet
+	/// </summary>
+	/// <param name="output"> - buffer to fill</param>
+	/// <param name="alphabet"> - characters to choose from, with equal probabilities</param>
+	/// <param name="generator"> - random bit generator</param>
+	/// <returns>false if the alphabet is empty, the buffer is unchanged then</returns>
+	template<typename TGenerator>
+	static bool Fill(std::span<char> output, std::string_view alphabet, TGenerator& generator) noexcept
+	{
+		const std::size_t size = alphabet.size();
+
+		if(size == 0)
+		{
+			return false;
+		}
+
+		if(size == 1)
+		{
+			std::ranges::fill(output, alphabet[0]);
+			return true;
+		}
+
+		if(std::has_single_bit(size) && size <= 256)
+		{
+			switch(std::countr_zero(size))
+			{
+				case 1: FillFields<1>(output.data(), output.size(), alphabet.data(), generator); break;
+				case 2: FillFields<2>(output.data(), output.size(), alphabet.data(), generator); break;
+				case 3: FillFields<3>(output.data(), output.size(), alphabet.data(), generator); break;
+				case 4: FillFields<4>(output.data(), output.size(), alphabet.data(), generator); break;
+				case 5: FillFields<5>(output.data(), output.size(), alphabet.data(), generator); break;
+				case 6: FillFields<6>(output.data(), output.size(), alphabet.data(), generator); break;
+				case 7: FillFields<7>(output.data(), output.size(), alphabet.data(), generator); break;
+				default: FillFields<8>(output.data(), output.size(), alphabet.data(), generator); break;
+			}
+
+			return true;
+		}
+
+		if(size <= 256)
+		{
+			// Indices first, then characters in place: unsigned char may alias char
+			std::span<std::uint8_t> indices(reinterpret_cast<std::uint8_t*>(output.data()), output.size());
+
+			PackedFiller::Fill(indices, 0, static_cast<std::uint8_t>(size - 1), generator);
+
+			for(auto& item : output)
+			{
+				item = alphabet[static_cast<std::uint8_t>(item)];
+			}
+
+			return true;
+		}
+
+		for(auto& item : output)
+		{
+			item = alphabet[BoundedSampler<std::size_t>::Next(generator, 0, size - 1)];
+		}
+
+		return true;
+	}
+
+	/// <summary>
+	/// Write a random version 4 UUID as 36 lowercase characters, such as 0b1e4f0c-9d7a-4c2e-8f31-5a6b7c8d9e0f
+	/// </summary>
+	/// <param name="output"> - buffer of 36 characters</param>
+	/// <param name="generator"> - random bit generator</param>
+	template<typename TGenerator>
+	static void FillUuid(std::span<char, 36> output, TGenerator& generator) noexcept
+	{
+		constexpr std::size_t Positions[16] = { 0, 2, 4, 6, 9, 11, 14, 16, 19, 21, 24, 26, 28, 30, 32, 34 };
+		const std::uint64_t words[2] = { RandomBits::Next64(generator), RandomBits::Next64(generator) };
+		std::uint8_t bytes[16];
+
+		for(std::size_t i = 0; i < 16; i++)
+		{
+			bytes[i] = static_cast<std::uint8_t>(words[i / 8] >> (8 * (i % 8)));
+		}
+
+		// The version 4 and the variant 10xx of RFC 9562
+		bytes[6] = static_cast<std::uint8_t>((bytes[6] & 0x0f) | 0x40);
+		bytes[8] = static_cast<std::uint8_t>((bytes[8] & 0x3f) | 0x80);
+
+		RANDOM_UNROLL
+		for(std::size_t i = 0; i < 16; i++)
+		{
+			output[Positions[i]] = HexDigits[bytes[i] >> 4];
+			output[Positions[i] + 1] = HexDigits[bytes[i] & 0x0f];
+		}
+
+		output[8] = output[13] = output[18] = output[23] = '-';
+	}
+};
+
+/// <summary>
+/// Walker's alias table built by Vose's method: samples an index with probability
+/// proportional to its weight in O(1), with one bounded int and one double.
+/// The probabilities and the aliases are kept in separate arrays.
+/// Weights can be changed without a full rebuild: the table is built on upper bounds
+/// of the weights, and a column whose weight went down is accepted with probability weight / bound.
+/// The table is rebuilt when a weight grows above its bound or the total weight halves.
+/// </summary>
+class WeightedSampler
+{
+protected:
+	std::vector<double> _probabilities;
+	std::vector<std::uint32_t> _aliases;
+	std::vector<double> _weights;
+	std::vector<double> _bounds;
+	BoundedSampler<std::uint32_t> _column{ 0, 0 };
+	double _total = 0;
+	double _boundTotal = 0;
+	std::size_t _reduced = 0; // number of weights under their bounds
+
+	void Rebuild()
+	{
+		const std::size_t size = _weights.size();
+		std::vector<std::uint32_t> small, large;
+
+		_bounds = _weights;
+		_total = 0;
+		_reduced = 0;
+
+		for(double weight : _weights)
+		{
+			_total += weight;
+		}
+
+		_boundTotal = _total;
+
+		for(std::size_t i = 0; i < size; i++)
+		{
+			_probabilities[i] = _weights[i] * size / _total;
+			(_probabilities[i] < 1.0 ? small : large).push_back(static_cast<std::uint32_t>(i));
+		}
+
+		while(!small.empty() && !large.empty())
+		{
+			const std::uint32_t less = small.back(), more = large.back();
+
+			small.pop_back();
+			_aliases[less] = more;
+			_probabilities[more] -= 1.0 - _probabilities[less];
+
+			if(_probabilities[more] < 1.0)
+			{
+				large.pop_back();
+				small.push_back(more);
+			}
+		}
+
+		// What is left differs from 1 by rounding errors only
+		for(std::uint32_t i : small)
+		{
+			_probabilities[i] = 1.0;
+			_aliases[i] = i;
+		}
+
+		for(std::uint32_t i : large)
+		{
+			_probabilities[i] = 1.0;
+			_aliases[i] = i;
+		}
+	}
+public:
+	/// <summary>
+	/// Build the table in O(n)
+	/// </summary>
+	/// <param name="weights"> - non-negative weights, at least one of them is positive</param>
+	/// <exception cref="std::invalid_argument">if no weight is positive</exception>
+	template<typename TRange> requires IsArithmeticRange<TRange>
+	explicit WeightedSampler(TRange&& weights)
+	{
+		for(const auto& weight : weights)
+		{
+			_weights.push_back(static_cast<double>(weight));
+		}
+
+		if(std::ranges::none_of(_weights, [](double weight) { return weight > 0; }))
+		{
+			throw std::invalid_argument("WeightedSampler: no weight is positive");
+		}
+
+		_probabilities.resize(_weights.size());
+		_aliases.resize(_weights.size());
+		_column = BoundedSampler<std::uint32_t>(0, static_cast<std::uint32_t>(_weights.size() - 1));
+		Rebuild();
+	}
+
+	std::size_t Size() const noexcept
+	{
+		return _weights.size();
+	}
+
+	double Weight(std::size_t index) const noexcept
+	{
+		return _weights[index];
+	}
+
+	/// <summary>
+	/// Change one weight. Takes O(1) unless the weight grows above the bound it was built with
+	/// or the total weight falls under a half of the built one, then the table is rebuilt in O(n).
+	/// </summary>
+	/// <param name="index"> - index of the weight</param>
+	/// <param name="weight"> - new non-negative weight</param>
+	void SetWeight(std::size_t index, double weight)
+	{
+		const bool wasReduced = _weights[index] != _bounds[index];
+
+		_total += weight - _weights[index];
+		_weights[index] = weight;
+
+		if(weight > _bounds[index] || _total < _boundTotal / 2)
+		{
+			Rebuild();
+			return;
+		}
+
+		_reduced += (weight != _bounds[index]) - wasReduced;
+	}
+
+	/// <summary>
+	/// Generate a random index with probability Weight(index) / sum of the weights
+	/// </summary>
+	/// <param name="generator"> - random bit generator</param>
+	/// <returns>a random index in a range [0, Size())</returns>
+	template<typename TGenerator> requires std::uniform_random_bit_generator<TGenerator>
+	std::size_t operator()(TGenerator& generator) const noexcept
+	{
+		while(true)
+		{
+			const std::uint32_t column = _column(generator);
+			const double unit = RandomBits::ToDouble(RandomBits::Next64(generator));
+			const std::uint32_t index = unit < _probabilities[column] ? column : _aliases[column];
+
+			if(_reduced == 0 || _weights[index] == _bounds[index] ||
+			   RandomBits::ToDouble(RandomBits::Next64(generator)) * _bounds[index] < _weights[index])
+			{
+				return index;
+			}
+		}
+	}
+};
+
+/// <summary>
+/// Fills a block of raw 64-bit outputs in one pass and serves them one by one,
+/// so that mixed scalar calls pay for the engine once per block.
+/// Xoshiro256PlusPlusX8 fills the block with its vectorized kernel.
+/// </summary>
+template<typename TEngine>
+class BufferedEngine
+{
+public:
+	using result_type = std::uint64_t;
+
+	/// <summary>
+	/// Block of 4 KiB
+	/// </summary>
+	static constexpr std::size_t BlockSize = 4096 / sizeof(std::uint64_t);
+protected:
+	alignas(64) std::uint64_t _block[BlockSize];
+	std::size_t _position = BlockSize;
+	TEngine _engine;
+public:
+	/// <summary>
+	/// Fill a block with BlockSize raw 64-bit outputs of the engine
+	/// </summary>
+	static void FillBlock(TEngine& engine, std::uint64_t* block) noexcept
+	{
+		if constexpr(requires { engine.FillBits(block, BlockSize); })
+		{
+			engine.FillBits(block, BlockSize);
+		}
+		else
+		{
+			for(std::size_t i = 0; i < BlockSize; i++)
+			{
+				block[i] = RandomBits::Next64(engine);
+			}
+		}
+	}
+
+	explicit BufferedEngine(std::uint64_t value) noexcept:
+		_engine(value)
+	{}
+
+	explicit BufferedEngine(const TEngine& engine) noexcept:
+		_engine(engine)
+	{}
+
+	/// <summary>
+	/// The engine behind the block, advanced past every output in the block
+	/// </summary>
+	const TEngine& Engine() const noexcept
+	{
+		return _engine;
+	}
+
+	static constexpr result_type min() noexcept
+	{
+		return 0;
+	}
+
+	static constexpr result_type max() noexcept
+	{
+		return UINT64_MAX;
+	}
+
+	result_type operator()() noexcept
+	{
+		if(_position == BlockSize) [[unlikely]]
+		{
+			FillBlock(_engine, _block);
+			_position = 0;
+		}
+
+		return _block[_position++];
+	}
+
+	/// <summary>
+	/// Take a whole new block at once, the rest of the current one is dropped
+	/// </summary>
+	/// <returns>BlockSize raw outputs, valid until the next call to the engine</returns>
+	const std::uint64_t* NextBlock() noexcept
+	{
+		FillBlock(_engine, _block);
+		_position = BlockSize;
+		return _block;
+	}
+};
+
+/// <summary>
+/// Thread-safe variant of BufferedEngine. Every thread serves itself from its own block
+/// and takes the lock only to refill it, once per BlockSize outputs. A thread has one block
+/// per engine type, so when it alternates between two objects the rest of the block is dropped.
+/// </summary>
+template<typename TEngine>
+class SharedBufferedEngine
+{
+public:
+	using result_type = std::uint64_t;
+
+	static constexpr std::size_t BlockSize = BufferedEngine<TEngine>::BlockSize;
+protected:
+	struct ThreadBlock
+	{
+		alignas(64) std::uint64_t Values[BlockSize];
+		std::size_t Position;
+		std::uint64_t Owner;
+	};
+
+	static inline std::atomic<std::uint64_t> _lastId = 0;
+	static inline thread_local ThreadBlock _threadBlock;
+
+	std::mutex _mutex;
+	TEngine _engine;
+	const std::uint64_t _id = ++_lastId;
+
+	void Refill(ThreadBlock& block) noexcept
+	{
+		{
+			RandomLockGuard lock(_mutex);
+			BufferedEngine<TEngine>::FillBlock(_engine, block.Values);
+		}
+
+		block.Position = 0;
+		block.Owner = _id;
+	}
+public:
+	explicit SharedBufferedEngine(std::uint64_t value) noexcept:
+		_engine(value)
+	{}
+
+	explicit SharedBufferedEngine(const TEngine& engine) noexcept:
+		_engine(engine)
+	{}
+
+	static constexpr result_type min() noexcept
+	{
+		return 0;
+	}
+
+	static constexpr result_type max() noexcept
+	{
+		return UINT64_MAX;
+	}
+
+	result_type operator()() noexcept
+	{
+		ThreadBlock& block = _threadBlock;
+
+		if(block.Owner != _id || block.Position == BlockSize) [[unlikely]]
+		{
+			Refill(block);
+		}
+
+		return block.Values[block.Position++];
+	}
+};
+
+/// <summary>
+/// Ziggurat method by G. Marsaglia and W. W. Tsang with 256 layers for the normal
+/// and the exponential distributions: one 64-bit number and one table lookup in 99% of draws.
+/// The low 8 bits select a layer, the 9th bit is a sign and the upper 53 bits are a magnitude.
+/// </summary>
+class Ziggurat
+{
+protected:
+	static constexpr std::size_t Layers = 256;
+	static constexpr double Scale = 0x1.0p53;
+	static constexpr double NormalTailStart = 3.6541528853610088;
+	static constexpr double NormalLayerArea = 0.00492867323399;
+	static constexpr double ExponentialTailStart = 7.69711747013104972;
+	static constexpr double ExponentialLayerArea = 0.0039496598225815571993;
+
+	struct Tables
+	{
+		std::uint64_t NormalK[Layers];
+		double NormalW[Layers];
+		double NormalF[Layers];
+		std::uint64_t ExponentialK[Layers];
+		double ExponentialW[Layers];
+		double ExponentialF[Layers];
+
+		Tables() noexcept
+		{
+			double x = NormalTailStart, next = x;
+			double q = NormalLayerArea / std::exp(-0.5 * x * x);
+
+			NormalK[0] = static_cast<std::uint64_t>(x / q * Scale);
+			NormalK[1] = 0;
+			NormalW[0] = q / Scale;
+			NormalW[Layers - 1] = x / Scale;
+			NormalF[0] = 1.0;
+			NormalF[Layers - 1] = std::exp(-0.5 * x * x);
+
+			for(std::size_t i = Layers - 2; i >= 1; i--)
+			{
+				x = std::sqrt(-2.0 * std::log(NormalLayerArea / x + std::exp(-0.5 * x * x)));
+				NormalK[i + 1] = static_cast<std::uint64_t>(x / next * Scale);
+				next = x;
+				NormalF[i] = std::exp(-0.5 * x * x);
+				NormalW[i] = x / Scale;
+			}
+
+			x = next = ExponentialTailStart;
+			q = ExponentialLayerArea / std::exp(-x);
+
+			ExponentialK[0] = static_cast<std::uint64_t>(x / q * Scale);
+			ExponentialK[1] = 0;
+			ExponentialW[0] = q / Scale;
+			ExponentialW[Layers - 1] = x / Scale;
+			ExponentialF[0] = 1.0;
+			ExponentialF[Layers - 1] = std::exp(-x);
+
+			for(std::size_t i = Layers - 2; i >= 1; i--)
+			{
+				x = -std::log(ExponentialLayerArea / x + std::exp(-x));
+				ExponentialK[i + 1] = static_cast<std::uint64_t>(x / next * Scale);
+				next = x;
+				ExponentialF[i] = std::exp(-x);
+				ExponentialW[i] = x / Scale;
+			}
+		}
+	};
+
+	static const Tables& GetTables() noexcept
+	{
+		static const Tables tables;
+		return tables;
+	}
+
+	/// <summary>
+	/// Random number in a range (0, 1]
+	/// </summary>
+	template<typename TGenerator>
+	static double OpenUnit(TGenerator& generator) noexcept
+	{
+		return 1.0 - RandomBits::ToDouble(RandomBits::Next64(generator));
+	}
+
+	template<typename TGenerator>
+	static double NormalTail(TGenerator& generator, bool negative) noexcept
+	{
+		double x, y;
+
+		do
+		{
+			x = std::log(OpenUnit(generator)) / NormalTailStart;
+			y = std::log(OpenUnit(generator));
+		}
+		while(-2.0 * y < x * x);
+
+		return negative ? x - NormalTailStart : NormalTailStart - x;
+	}
+public:
+	/// <summary>
+	/// Normal number of the upper layers of the ziggurat, accepted if it lies inside the layer.
+	/// The sign is set without a branch, it is unpredictable.
+	/// </summary>
+	static RANDOM_ALWAYS_INLINE double NormalLayer(const Tables& tables, std::uint64_t bits, bool& accepted) noexcept
+	{
+		const std::size_t layer = bits & 0xff;
+		const std::uint64_t magnitude = bits >> 11;
+		const double x = static_cast<double>(static_cast<std::int64_t>(magnitude)) * tables.NormalW[layer];
+
+		accepted = magnitude < tables.NormalK[layer];
+		return std::bit_cast<double>(std::bit_cast<std::uint64_t>(x) | ((bits & 0x100) << 55));
+	}
+
+	/// <summary>
+	/// The rare rest of the normal draw whose bits were not accepted by NormalLayer:
+	/// the tail or the wedge of the layer, and a new draw if the wedge rejects
+	/// </summary>
+	template<typename TGenerator>
+	static double NormalRejected(TGenerator& generator, std::uint64_t bits) noexcept
+	{
+		const Tables& tables = GetTables();
+		const std::size_t layer = bits & 0xff;
+
+		if(layer == 0)
+		{
+			return NormalTail(generator, bits & 0x100);
+		}
+
+		const double x = static_cast<double>(static_cast<std::int64_t>(bits >> 11)) * tables.NormalW[layer];
+		const double f = tables.NormalF[layer];
+
+		if(f + RandomBits::ToDouble(RandomBits::Next64(generator)) * (tables.NormalF[layer - 1] - f) < std::exp(-0.5 * x * x))
+		{
+			return (bits & 0x100) ? -x : x;
+		}
+
+		RandomStatistics::CountRejection();
+		return Normal(generator);
+	}
+
+	static RANDOM_ALWAYS_INLINE double ExponentialLayer(const Tables& tables, std::uint64_t bits, bool& accepted) noexcept
+	{
+		const std::size_t layer = bits & 0xff;
+		const std::uint64_t magnitude = bits >> 11;
+
+		accepted = magnitude < tables.ExponentialK[layer];
+		return static_cast<double>(static_cast<std::int64_t>(magnitude)) * tables.ExponentialW[layer];
+	}
+
+	template<typename TGenerator>
+	static double ExponentialRejected(TGenerator& generator, std::uint64_t bits) noexcept
+	{
+		const Tables& tables = GetTables();
+		const std::size_t layer = bits & 0xff;
+
+		if(layer == 0)
+		{
+			// The tail is exponential again
+			return ExponentialTailStart - std::log(OpenUnit(generator));
+		}
+
+		const double x = static_cast<double>(static_cast<std::int64_t>(bits >> 11)) * tables.ExponentialW[layer];
+		const double f = tables.ExponentialF[layer];
+
+		if(f + RandomBits::ToDouble(RandomBits::Next64(generator)) * (tables.ExponentialF[layer - 1] - f) < std::exp(-x))
+		{
+			return x;
+		}
+
+		RandomStatistics::CountRejection();
+		return Exponential(generator);
+	}
+
+	/// <summary>
+	/// Fill a block without branches on the rejections, then redo the rejected elements
+	/// </summary>
+	template<typename TReal, typename TEngine, typename TLayer, typename TRejected>
+	static RANDOM_ALWAYS_INLINE void FillBlocks(TReal* output, std::size_t count, double offset, double scale,
+												BufferedEngine<TEngine>& engine, TLayer&& layer, TRejected&& rejected) noexcept
+	{
+		constexpr std::size_t BlockSize = BufferedEngine<TEngine>::BlockSize;
+		const Tables& tables = GetTables();
+		std::uint64_t rejectedBits[BlockSize];
+		std::uint32_t rejectedIndices[BlockSize];
+
+		for(std::size_t i = 0; i < count; i += BlockSize)
+		{
+			const std::uint64_t* bits = engine.NextBlock();
+			const std::size_t size = std::min(BlockSize, count - i);
+			std::size_t rejectedCount = 0;
+
+			for(std::size_t j = 0; j < size; j++)
+			{
+				bool accepted;
+
+				output[i + j] = static_cast<TReal>(offset + scale * layer(tables, bits[j], accepted));
+				rejectedBits[rejectedCount] = bits[j];
+				rejectedIndices[rejectedCount] = static_cast<std::uint32_t>(j);
+				rejectedCount += !accepted;
+			}
+
+			// The block of the engine is overwritten from here on
+			for(std::size_t j = 0; j < rejectedCount; j++)
+			{
+				output[i + rejectedIndices[j]] = static_cast<TReal>(offset + scale * rejected(engine, rejectedBits[j]));
+			}
+		}
+	}
+public:
+	/// <summary>
+	/// Generate a normally distributed random number with mean 0 and deviation 1
+	/// </summary>
+	/// <param name="generator"> - random bit generator</param>
+	template<typename TGenerator>
+	static RANDOM_ALWAYS_INLINE double Normal(TGenerator& generator) noexcept
+	{
+		const std::uint64_t bits = RandomBits::Next64(generator);
+		bool accepted;
+		const double value = NormalLayer(GetTables(), bits, accepted);
+
+		if(accepted) [[likely]]
+		{
+			return value;
+		}
+
+		return NormalRejected(generator, bits);
+	}
+
+	/// <summary>
+	/// Generate an exponentially distributed random number with rate 1
+	/// </summary>
+	/// <param name="generator"> - random bit generator</param>
+	template<typename TGenerator>
+	static RANDOM_ALWAYS_INLINE double Exponential(TGenerator& generator) noexcept
+	{
+		const std::uint64_t bits = RandomBits::Next64(generator);
+		bool accepted;
+		const double value = ExponentialLayer(GetTables(), bits, accepted);
+
+		if(accepted) [[likely]]
+		{
+			return value;
+		}
+
+		return ExponentialRejected(generator, bits);
+	}
+
+	/// <summary>
+	/// Fill an array with normally distributed random numbers
+	/// </summary>
+	/// <param name="output"> - array of numbers</param>
+	/// <param name="count"> - number of elements</param>
+	/// <param name="mean"> - mean</param>
+	/// <param name="deviation"> - standard deviation</param>
+	/// <param name="engine"> - buffered engine, its blocks are taken whole</param>
+	template<typename TReal, typename TEngine>
+	static void FillNormal(TReal* output, std::size_t count, double mean, double deviation, BufferedEngine<TEngine>& engine) noexcept
+	{
+		FillBlocks(output, count, mean, deviation, engine,
+				   [](const Tables& tables, std::uint64_t bits, bool& accepted) { return NormalLayer(tables, bits, accepted); },
+				   [](BufferedEngine<TEngine>& generator, std::uint64_t bits) { return NormalRejected(generator, bits); });
+	}
+
+	/// <summary>
+	/// Fill an array with exponentially distributed random numbers
+	/// </summary>
+	/// <param name="output"> - array of numbers</param>
+	/// <param name="count"> - number of elements</param>
+	/// <param name="scale"> - mean, the inverse of the rate</param>
+	/// <param name="engine"> - buffered engine, its blocks are taken whole</param>
+	template<typename TReal, typename TEngine>
+	static void FillExponential(TReal* output, std::size_t count, double scale, BufferedEngine<TEngine>& engine) noexcept
+	{
+		FillBlocks(output, count, 0.0, scale, engine,
+				   [](const Tables& tables, std::uint64_t bits, bool& accepted) { return ExponentialLayer(tables, bits, accepted); },
+				   [](BufferedEngine<TEngine>& generator, std::uint64_t bits) { return ExponentialRejected(generator, bits); });
+	}
+};
+
+/// <summary>
+/// Normal distribution, sampled with the ziggurat method
+/// </summary>
+class NormalDistribution
+{
+protected:
+	double _mean;
+	double _deviation;
+public:
+	/// <param name="mean"> - mean</param>
+	/// <param name="deviation"> - standard deviation</param>
+	NormalDistribution(double mean = 0.0, double deviation = 1.0) noexcept:
+		_mean(mean),
+		_deviation(deviation)
+	{}
+
+	double Mean() const noexcept
+	{
+		return _mean;
+	}
+
+	double Deviation() const noexcept
+	{
+		return _deviation;
+	}
+
+	template<typename TGenerator> requires std::uniform_random_bit_generator<TGenerator>
+	double operator()(TGenerator& generator) const noexcept
+	{
+		return _mean + _deviation * Ziggurat::Normal(generator);
+	}
+
+	/// <summary>
+	/// Fill an array with random numbers of the distribution
+	/// </summary>
+	/// <param name="output"> - array of numbers</param>
+	/// <param name="count"> - number of elements</param>
+	/// <param name="engine"> - buffered engine</param>
+	template<typename TValue, typename TEngine> requires std::is_floating_point_v<TValue>
+	void Fill(TValue* output, std::size_t count, BufferedEngine<TEngine>& engine) const noexcept
+	{
+		Ziggurat::FillNormal(output, count, _mean, _deviation, engine);
+	}
+};
+
+/// <summary>
+/// Exponential distribution, sampled with the ziggurat method
+/// </summary>
+class ExponentialDistribution
+{
+protected:
+	double _scale;
+public:
+	/// <param name="rate"> - rate, the inverse of the mean</param>
+	ExponentialDistribution(double rate = 1.0) noexcept:
+		_scale(1.0 / rate)
+	{}
+
+	double Rate() const noexcept
+	{
+		return 1.0 / _scale;
+	}
+
+	template<typename TGenerator> requires std::uniform_random_bit_generator<TGenerator>
+	double operator()(TGenerator& generator) const noexcept
+	{
+		return _scale * Ziggurat::Exponential(generator);
+	}
+
+	/// <summary>
+	/// Fill an array with random numbers of the distribution
+	/// </summary>
+	/// <param name="output"> - array of numbers</param>
+	/// <param name="count"> - number of elements</param>
+	/// <param name="engine"> - buffered engine</param>
+	template<typename TValue, typename TEngine> requires std::is_floating_point_v<TValue>
+	void Fill(TValue* output, std::size_t count, BufferedEngine<TEngine>& engine) const noexcept
+	{
+		Ziggurat::FillExponential(output, count, _scale, engine);
+	}
+};
+
+/// <summary>
+/// Poisson distribution. Small means are sampled by inversion, means from 10 on
+/// by the transformed rejection with squeeze (PTRS) by W. Hörmann.
+/// </summary>
+class PoissonDistribution
+{
+protected:
+	static constexpr double InversionLimit = 10.0;
+
+	double _mean;
+	double _exponent; // exp(-mean) for the inversion, log(mean) for PTRS
+	double _a = 0;
+	double _b = 0;
+	double _inverseAlpha = 0;
+	double _squeeze = 0;
+
+	template<typename TGenerator>
+	std::uint64_t Invert(TGenerator& generator) const noexcept
+	{
+		const double unit = RandomBits::ToDouble(RandomBits::Next64(generator));
+		double probability = _exponent, sum = probability;
+		std::uint64_t k = 0;
+
+		while(unit >= sum && probability > 0)
+		{
+			k++;
+			probability *= _mean / k;
+			sum += probability;
+		}
+
+		return k;
+	}
+
+	template<typename TGenerator>
+	std::uint64_t TransformedRejection(TGenerator& generator) const noexcept
+	{
+		while(true)
+		{
+			const double u = RandomBits::ToDouble(RandomBits::Next64(generator)) - 0.5;
+			const double v = RandomBits::ToDouble(RandomBits::Next64(generator));
+			const double us = 0.5 - std::abs(u);
+			const double k = std::floor((2.0 * _a / us + _b) * u + _mean + 0.43);
+
+			if(us >= 0.07 && v <= _squeeze)
+			{
+				return static_cast<std::uint64_t>(k);
+			}
+
+			if(k < 0 || (us < 0.013 && v > us))
+			{
+				continue;
+			}
+
+			if(std::log(v) + std::log(_inverseAlpha) - std::log(_a / (us * us) + _b) <= -_mean + k * _exponent - std::lgamma(k + 1))
+			{
+				return static_cast<std::uint64_t>(k);
+			}
+		}
+	}
+public:
+	/// <param name="mean"> - mean, not negative</param>
+	PoissonDistribution(double mean = 1.0) noexcept:
+		_mean(mean)
+	{
+		if(mean < InversionLimit)
+		{
+			_exponent = std::exp(-mean);
+			return;
+		}
+
+		_exponent = std::log(mean);
+		_b = 0.931 + 2.53 * std::sqrt(mean);
+		_a = -0.059 + 0.02483 * _b;
+		_inverseAlpha = 1.1239 + 1.1328 / (_b - 3.4);
+		_squeeze = 0.9277 - 3.6224 / (_b - 2);
+	}
+
+	double Mean() const noexcept
+	{
+		return _mean;
+	}
+
+	template<typename TGenerator> requires std::uniform_random_bit_generator<TGenerator>
+	std::uint64_t operator()(TGenerator& generator) const noexcept
+	{
+		return _mean < InversionLimit ? Invert(generator) : TransformedRejection(generator);
+	}
+};
+
+/// <summary>
+/// Runs the tasks of the parallel algorithms on a group of threads
+/// and derives their non-overlapping random streams
+/// </summary>
+class ParallelRunner
+{
+public:
+	/// <summary>
+	/// Number of threads used when 0 is passed as a thread count
+	/// </summary>
+	static unsigned DefaultThreadCount() noexcept
+	{
+		const unsigned count = std::thread::hardware_concurrency();
+		return count == 0 ? 1 : count;
+	}
+
+	/// <summary>
+	/// Run task(i) for every i in a range [0, count) on up to threadCount threads.
+	/// The calling thread takes part, and does all the work if no thread can be started.
+	/// </summary>
+	/// <param name="count"> - number of tasks</param>
+	/// <param name="threadCount"> - maximum number of threads, 0 for DefaultThreadCount()</param>
+	/// <param name="task"> - function called with a task index</param>
+	template<typename TTask>
+	static void Run(std::size_t count, unsigned threadCount, TTask&& task) noexcept
+	{
+		std::atomic<std::size_t> next = 0;
+		std::vector<std::thread> threads;
+		const auto work = [&]()
+		{
+			for(std::size_t i = next.fetch_add(1, std::memory_order_relaxed); i < count; i = next.fetch_add(1, std::memory_order_relaxed))
+			{
+				task(i);
+			}
+		};
+
+		if(threadCount == 0)
+		{
+			threadCount = DefaultThreadCount();
+		}
+
+		threadCount = static_cast<unsigned>(std::min<std::size_t>(threadCount, count));
+
+		try
+		{
+			threads.reserve(threadCount > 0 ? threadCount - 1 : 0);
+
+			for(unsigned i = 1; i < threadCount; i++)
+			{
+				threads.emplace_back(work);
+			}
+		}
+		catch(...)
+		{
+		}
+
+		work();
+
+		for(auto& thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	/// <summary>
+	/// Make engines for consecutive jump()-separated subsequences of one xoshiro256++ stream
+	/// </summary>
+	/// <param name="seed"> - seed of the stream</param>
+	/// <param name="count"> - number of engines</param>
+	/// <returns>engines which never overlap within 2^128 outputs</returns>
+	static std::vector<Xoshiro256PlusPlus> MakeStreams(std::uint64_t seed, std::size_t count)
+	{
+		std::vector<Xoshiro256PlusPlus> streams;
+		Xoshiro256PlusPlus stream(seed);
+
+		streams.reserve(count);
+
+		for(std::size_t i = 0; i < count; i++)
+		{
+			streams.push_back(stream);
+			stream.jump();
+		}
+
+		return streams;
+	}
+
+	/// <summary>
+	/// Make engines for consecutive long_jump()-separated subsequences of one xoshiro256++ stream,
+	/// each of them has room for 2^64 jump()-separated subsequences
+	/// </summary>
+	/// <param name="seed"> - seed of the stream</param>
+	/// <param name="count"> - number of engines</param>
+	/// <returns>engines which never overlap within 2^192 outputs</returns>
+	static std::vector<Xoshiro256PlusPlus> MakeLongStreams(std::uint64_t seed, std::size_t count)
+	{
+		std::vector<Xoshiro256PlusPlus> streams;
+		Xoshiro256PlusPlus stream(seed);
+
+		streams.reserve(count);
+
+		for(std::size_t i = 0; i < count; i++)
+		{
+			streams.push_back(stream);
+			stream.long_jump();
+		}
+
+		return streams;
+	}
+};
+
+/// <summary>
+/// Lazy random subsample of a sized range, the elements keep their order.
+/// Uses Vitter's Method A: one random number per selected element, elements between them are skipped.
+/// Every iteration draws from its own copy of the engine of the view, so iterating the view again
+/// or iterating a copy of it yields the same subsample.
+/// </summary>
+template<std::ranges::view TView> requires std::ranges::input_range<TView> && std::ranges::sized_range<TView>
+class RandomSampleView: public std::ranges::view_interface<RandomSampleView<TView>>
+{
+protected:
+	TView _base;
+	std::size_t _count = 0;
+	Xoshiro256PlusPlus _engine;
+
+	/// <summary>
+	/// Number of records to skip before the next selected one
+	/// </summary>
+	static std::size_t Skip(Xoshiro256PlusPlus& engine, std::size_t records, std::size_t selections) noexcept
+	{
+		const double unit = RandomBits::ToDouble(RandomBits::Next64(engine));
+
+		if(selections == 1)
+		{
+			return std::min(records - 1, static_cast<std::size_t>(unit * records));
+		}
+
+		double top = static_cast<double>(records - selections);
+		double all = static_cast<double>(records);
+		double quotient = top / all;
+		std::size_t skip = 0;
+
+		while(quotient > unit)
+		{
+			skip++;
+			top--;
+			all--;
+			quotient *= top / all;
+		}
+
+		return skip;
+	}
+
+	class Iterator
+	{
+	protected:
+		Xoshiro256PlusPlus _engine;
+		std::ranges::iterator_t<TView> _current;
+		std::size_t _records = 0;
+		std::size_t _selections = 0;
+
+		void SkipToSelected() noexcept
+		{
+			if(_selections > 0)
+			{
+				const std::size_t skip = Skip(_engine, _records, _selections);
+
+				std::ranges::advance(_current, static_cast<std::ranges::range_difference_t<TView>>(skip));
+				_records -= skip;
+			}
+		}
+	public:
+		using iterator_concept = std::input_iterator_tag;
+		using value_type = std::ranges::range_value_t<TView>;
+		using difference_type = std::ptrdiff_t;
+
+		Iterator() = default;
+
+		Iterator(RandomSampleView& parent) noexcept:
+			_engine(parent._engine),
+			_current(std::ranges::begin(parent._base)),
+			_records(std::ranges::size(parent._base)),
+			_selections(std::min(parent._count, _records))
+		{
+			SkipToSelected();
+		}
+
+		decltype(auto) operator*() const noexcept
+		{
+			return *_current;
+		}
+
+		Iterator& operator++() noexcept
+		{
+			++_current;
+			_records--;
+			_selections--;
+			SkipToSelected();
+			return *this;
+		}
+
+		void operator++(int) noexcept
+		{
+			++*this;
+		}
+
+		friend bool operator==(const Iterator& iterator, std::default_sentinel_t) noexcept
+		{
+			return iterator._selections == 0;
+		}
+	};
+public:
+	RandomSampleView() = default;
+
+	/// <param name="base"> - view to take the elements from</param>
+	/// <param name="count"> - number of elements to select</param>
+	/// <param name="seed"> - seed of the engine of the view</param>
+	RandomSampleView(TView base, std::size_t count, std::uint64_t seed) noexcept:
+		_base(std::move(base)),
+		_count(count),
+		_engine(seed)
+	{}
+
+	Iterator begin() noexcept
+	{
+		return Iterator(*this);
+	}
+
+	std::default_sentinel_t end() const noexcept
+	{
+		return std::default_sentinel;
+	}
+
+	std::size_t size() noexcept
+	{
+		return std::min<std::size_t>(_count, std::ranges::size(_base));
+	}
+};
+
+/// <summary>
+/// Pseudo-random bijection of [0, size) in O(1) memory: a balanced Feistel network on the smallest
+/// even number of bits that covers size, with cycle-walking until the image falls into [0, size).
+/// The domain is at most four times larger than size, so an index takes less than four encryptions on average.
+/// The order is as good as that of a seeded generator, but not all size! permutations can appear.
+/// </summary>
+class FeistelPermutation
+{
+protected:
+	// Short halves mix slowly, so small domains take more rounds
+	static constexpr int MaxRounds = 12;
+	static constexpr int LargeDomainRounds = 6;
+
+	std::uint64_t _size = 0;
+	int _halfBits = 1;
+	int _rounds = MaxRounds;
+	std::uint64_t _offset = 0;
+	std::uint64_t _keys[MaxRounds]{};
+
+	constexpr std::uint64_t Encrypt(std::uint64_t value) const noexcept
+	{
+		const std::uint64_t mask = (std::uint64_t(1) << _halfBits) - 1;
+
+		// Feistel rounds are even permutations, the rotation by a random offset makes the parity random
+		value = (value + _offset) & ((mask << _halfBits) | mask);
+
+		std::uint64_t left = value >> _halfBits;
+		std::uint64_t right = value & mask;
+
+		for(int round = 0; round < _rounds; round++)
+		{
+			// The SplitMix64 finalizer as the round function
+			std::uint64_t mixed = right + _keys[round];
+
+			mixed = (mixed ^ (mixed >> 30)) * 0xbf58476d1ce4e5b9;
+			mixed = (mixed ^ (mixed >> 27)) * 0x94d049bb133111eb;
+			mixed ^= mixed >> 31;
+
+			left = std::exchange(right, left ^ (mixed & mask));
+		}
+
+		return (left << _halfBits) | right;
+	}
+public:
+	constexpr FeistelPermutation() noexcept = default;
+
+	/// <param name="size"> - number of indices</param>
+	/// <param name="seed"> - seed of the round keys</param>
+	constexpr FeistelPermutation(std::uint64_t size, std::uint64_t seed) noexcept:
+		_size(size),
+		_halfBits(std::max(1, static_cast<int>(std::bit_width(size > 1 ? size - 1 : 1) + 1) / 2)),
+		_rounds(_halfBits > 8 ? LargeDomainRounds : MaxRounds)
+	{
+		SplitMix64 expander(seed);
+
+		_offset = expander();
+
+		for(auto& key : _keys)
+		{
+			key = expander();
+		}
+	}
+
+	constexpr std::uint64_t Size() const noexcept
+	{
+		return _size;
+	}
+
+	/// <summary>
+	/// Image of an index
+	/// </summary>
+	/// <param name="index"> - index in a range [0, Size())</param>
+	/// <returns>the index at the position index of the permutation</returns>
+	constexpr std::uint64_t operator()(std::uint64_t index) const noexcept
+	{
+		do
+		{
+			index = Encrypt(index);
+		}
+		while(index >= _size);
+
+		return index;
+	}
+};
+
+/// <summary>
+/// Lazy view of a sized range in a random order, given by a FeistelPermutation: nothing is copied or allocated.
+/// Element i of the view is element permutation(i) of the base, so for a range without random access
+/// every element costs a walk from the beginning of the base.
+/// Iterating a copy of the view yields the same order.
+/// </summary>
+template<std::ranges::view TView> requires std::ranges::forward_range<TView> && std::ranges::sized_range<TView>
+class RandomShuffledView: public std::ranges::view_interface<RandomShuffledView<TView>>
+{
+protected:
+	TView _base;
+	FeistelPermutation _permutation;
+
+	class Iterator
+	{
+	protected:
+		RandomShuffledView* _parent = nullptr;
+		std::ptrdiff_t _index = 0;
+	public:
+		using iterator_concept = std::conditional_t<std::ranges::random_access_range<TView>,
+													std::random_access_iterator_tag, std::forward_iterator_tag>;
+		using iterator_category = std::input_iterator_tag;
+		using value_type = std::ranges::range_value_t<TView>;
+		using difference_type = std::ptrdiff_t;
+
+		Iterator() = default;
+
+		Iterator(RandomShuffledView& parent, std::ptrdiff_t index) noexcept:
+			_parent(&parent),
+			_index(index)
+		{}
+
+		std::ranges::range_reference_t<TView> operator*() const noexcept
+		{
+			const auto position = static_cast<std::ranges::range_difference_t<TView>>(_parent->_permutation(static_cast<std::uint64_t>(_index)));
+
+			return *std::ranges::next(std::ranges::begin(_parent->_base), position);
+		}
+
+		std::ranges::range_reference_t<TView> operator[](difference_type offset) const noexcept
+		{
+			return *(*this + offset);
+		}
+
+		Iterator& operator++() noexcept
+		{
+			++_index;
+			return *this;
+		}
+
+		Iterator operator++(int) noexcept
+		{
+			Iterator copy = *this;
+			++_index;
+			return copy;
+		}
+
+		Iterator& operator--() noexcept
+		{
+			--_index;
+			return *this;
+		}
+
+		Iterator operator--(int) noexcept
+		{
+			Iterator copy = *this;
+			--_index;
+			return copy;
+		}
+
+		Iterator& operator+=(difference_type offset) noexcept
+		{
+			_index += offset;
+			return *this;
+		}
+
+		Iterator& operator-=(difference_type offset) noexcept
+		{
+			_index -= offset;
+			return *this;
+		}
+
+		friend Iterator operator+(Iterator iterator, difference_type offset) noexcept
+		{
+			return iterator += offset;
+		}
+
+		friend Iterator operator+(difference_type offset, Iterator iterator) noexcept
+		{
+			return iterator += offset;
+		}
+
+		friend Iterator operator-(Iterator iterator, difference_type offset) noexcept
+		{
+			return iterator -= offset;
+		}
+
+		friend difference_type operator-(const Iterator& left, const Iterator& right) noexcept
+		{
+			return left._index - right._index;
+		}
+
+		friend bool operator==(const Iterator& left, const Iterator& right) noexcept
+		{
+			return left._index == right._index;
+		}
+
+		friend auto operator<=>(const Iterator& left, const Iterator& right) noexcept
+		{
+			return left._index <=> right._index;
+		}
+	};
+public:
+	RandomShuffledView() = default;
+
+	/// <param name="base"> - view to take the elements from</param>
+	/// <param name="seed"> - seed of the permutation</param>
+	RandomShuffledView(TView base, std::uint64_t seed) noexcept:
+		_base(std::move(base)),
+		_permutation(std::ranges::size(_base), seed)
+	{}
+
+	Iterator begin() noexcept
+	{
+		return Iterator(*this, 0);
+	}
+
+	Iterator end() noexcept
+	{
+		return Iterator(*this, static_cast<std::ptrdiff_t>(_permutation.Size()));
+	}
+
+	std::size_t size() const noexcept
+	{
+		return static_cast<std::size_t>(_permutation.Size());
+	}
+};
+
+/// <summary>
+/// Engine whose object representation is its whole state. Excludes handles to state
+/// stored elsewhere, such as ThreadLocalEngine, and engines shared between threads.
+/// </summary>
+template<typename TEngine>
+concept IsSerializableEngine = std::is_trivially_copyable_v<TEngine> && std::is_copy_constructible_v<TEngine> &&
+							   !std::is_empty_v<TEngine>;
+
+/// <summary>
+/// Engine that a child generator can be made of: a copyable engine seeded by a number or by std::seed_seq.
+/// Empty handles such as ThreadLocalEngine keep no state of their own to split.
+/// </summary>
+template<typename TEngine>
+concept IsSplittableEngine = std::copy_constructible<TEngine> && !std::is_empty_v<TEngine> &&
+							 (std::constructible_from<TEngine, std::seed_seq&> || std::constructible_from<TEngine, typename TEngine::result_type>);
+
+/// <summary>
+/// Counter-based engine such as Philox4x32: any element of its streams is computed or reached in O(1),
+/// and ranges are filled from its elements without changing the engine
+/// </summary>
+template<typename TEngine>
+concept IsCounterBasedEngine = requires(TEngine& engine, const TEngine& constEngine, std::uint64_t value, std::span<std::uint64_t> range)
+{
+	{ constEngine.At(value, value) } -> std::same_as<std::uint64_t>;
+	{ constEngine.Stream() } -> std::same_as<std::uint64_t>;
+	{ constEngine.Index() } -> std::same_as<std::uint64_t>;
+	engine.Seek(value, value);
+	constEngine.Fill(range, value);
+};
+
+/// <summary>
+/// Binary image of an engine for checkpoints. It is trivially copyable and has no pointers,
+/// so it can be written as is or mapped straight from a file. The image is valid only
+/// for the same engine type built by the same compiler for the same platform.
+/// </summary>
+template<typename TEngine>
+struct RandomState
+{
+	static constexpr std::uint32_t CurrentVersion = 1;
+
+	std::uint32_t Version = CurrentVersion;
+	std::uint32_t EngineSize = sizeof(TEngine);
+	alignas(alignof(TEngine) > 8 ? alignof(TEngine) : 8) std::byte Engine[sizeof(TEngine)] = {};
+
+	/// <summary>
+	/// Check that the image was saved from the same engine type
+	/// </summary>
+	bool IsValid() const noexcept
+	{
+		return Version == CurrentVersion && EngineSize == sizeof(TEngine);
+	}
+};
+
+/// <summary>
+/// Selects the cache-aware Shuffle overload: elements are scattered into buckets that fit
+/// in the cache, then every bucket is shuffled on its own. For ranges much larger than the last level cache.
+/// </summary>
+struct CacheAwareShuffle
+{
+	/// <summary>
+	/// Maximum number of threads, 0 for all hardware threads
+	/// </summary>
+	unsigned ThreadCount = 1;
+};
+
+/// <summary>
+/// Process-wide source of seeds. Reads std::random_device once on the first use
+/// and then derives every next seed from that entropy and an atomic counter with SplitMix64,
+/// so taking a seed costs a few nanoseconds and keeps no file descriptor per object.
+/// Seeds are unique within the process.
+/// </summary>
+class SeedSource
+{
+protected:
+	static std::uint64_t ReadEntropy() noexcept
+	{
+		std::random_device device;
+		return (std::uint64_t(device()) << 32) | device();
+	}
+public:
+	/// <summary>
+	/// Take the next seed
+	/// </summary>
+	/// <returns>a unique 64-bit seed</returns>
+	static std::uint64_t Next() noexcept
+	{
+		static const std::uint64_t entropy = ReadEntropy();
+		static std::atomic<std::uint64_t> counter = 0;
+
+		return SplitMix64::Mix(entropy + SplitMix64::Gamma * counter.fetch_add(1, std::memory_order_relaxed));
+	}
+};
+
+/// <summary>
+/// Convenient interface over a random engine.
+/// Any std::uniform_random_bit_generator with seed(value) can be used as the engine:
+/// the standard ones or the included SplitMix64, Xoshiro256PlusPlus and Pcg64.
+/// Every object owns its engine, so objects never affect each other and a seeded object
+/// always gives the same sequence. The object holds nothing but its engine:
+/// 8 bytes for SplitMix64 and 32 bytes for Xoshiro256PlusPlus and Pcg64, which fit
+/// in one 64-byte cache line, against about 2.5 KB for std::mt19937. Objects used by different
+/// threads should not share a cache line, declare them alignas(64) when stored side by side.
+/// </summary>
+template<typename TEngine> requires std::uniform_random_bit_generator<TEngine>
+class BasicRandom
+{
+protected:	
+	TEngine _engine;
+
+	/// <summary>
+	/// The vectorized generator of the bulk paths. Engines that keep their own, like ThreadLocalEngine,
+	/// lend it, so its lanes continue their subsequences; other engines seed a new one with one output.
+	/// Counter-based engines never use it, so their ranges are filled from their own streams.
+	/// </summary>
+	decltype(auto) BulkGenerator() noexcept
+	{
+		if constexpr(requires { { _engine.BulkGenerator() } -> std::same_as<Xoshiro256PlusPlusX8&>; })
+		{
+			return _engine.BulkGenerator();
+		}
+		else
+		{
+			return Xoshiro256PlusPlusX8(RandomBits::Next64(_engine));
+		}
+	}
+
+	/// <summary>
+	/// Fill a contiguous range with the next elements of a counter-based engine and advance the engine past them.
+	/// Philox4x32 computes them with PhiloxKernel::Fill, so a device kernel given the key, the stream and the index
+	/// of the engine produces the same range.
+	/// </summary>
+	/// <param name="range"> - contiguous numeric range</param>
+	template<typename TRange> requires IsCounterBasedEngine<TEngine>
+	void FillElements(TRange&& range) noexcept
+	{
+		const std::uint64_t index = _engine.Index();
+
+		_engine.Fill(range, index);
+		_engine.Seek(_engine.Stream(), index + std::ranges::size(range));
+	}
+
+	/// <summary>
+	/// Fill memory with the bits of the next engine outputs, 8 bytes per output
+	/// </summary>
+	/// <param name="data"> - memory to fill</param>
+	/// <param name="size"> - number of bytes</param>
+	void FillEngineBytes(std::byte* data, std::size_t size) noexcept
+	{
+		if constexpr(IsCounterBasedEngine<TEngine>)
+		{
+			std::uint64_t block[64];
+
+			for(std::size_t i = 0; i < size; i += sizeof(block))
+			{
+				const std::size_t count = std::min(sizeof(block), size - i);
+
+				FillElements(std::span<std::uint64_t>(block, (count + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t)));
+				std::memcpy(data + i, block, count);
+			}
+		}
+		else
+		{
+			for(std::size_t i = 0; i < size; i += sizeof(std::uint64_t))
+			{
+				const std::uint64_t bits = RandomBits::Next64(_engine);
+				std::memcpy(data + i, &bits, std::min(sizeof(bits), size - i));
+			}
+		}
+	}
+
+	/// <summary>
+	/// Call fill(stream, chunk) for chunks of ParallelChunkSize elements on several threads.
+	/// Chunk c takes the c-th long_jump()-separated subsequence of the seed's stream, and fill
+	/// draws from the jump()-separated subsequences of that one only. So no two chunks share outputs,
+	/// and the result depends on the seed only.
+	/// </summary>
+	template<typename TRange, typename TFill>
+	static void ParallelFillChunks(TRange&& range, std::uint64_t seed, unsigned threadCount, TFill&& fill)
+	{
+		const std::size_t size = std::ranges::size(range);
+		const std::size_t chunks = (size + ParallelChunkSize - 1) / ParallelChunkSize;
+		const auto streams = ParallelRunner::MakeLongStreams(seed, chunks);
+		const auto begin = std::ranges::begin(range);
+
+		ParallelRunner::Run(chunks, threadCount, [&](std::size_t chunk)
+		{
+			const std::size_t first = chunk * ParallelChunkSize;
+			const std::size_t last = std::min(size, first + ParallelChunkSize);
+
+			fill(streams[chunk], std::ranges::subrange(begin + first, begin + last));
+		});
+	}
+
+	/// <summary>
+	/// Fill a chunk of ParallelFill from its stream only. Contiguous ranges go through
+	/// the bulk kernels of a Xoshiro256PlusPlusX8 whose lanes are jumped from the stream,
+	/// other ranges draw from the stream itself. Integers are in a range [min, max],
+	/// real numbers in a range [min, max).
+	/// </summary>
+	template<typename TRange>
+	static void FillFrom(const Xoshiro256PlusPlus& stream, TRange&& range, std::ranges::range_value_t<TRange> min,
+						 std::ranges::range_value_t<TRange> max) noexcept
+	{
+		using TValue = std::ranges::range_value_t<TRange>;
+
+		if constexpr(std::ranges::contiguous_range<TRange> && std::ranges::sized_range<TRange> && !std::is_same_v<TValue, bool>)
+		{
+			const std::size_t size = std::ranges::size(range);
+
+			if constexpr(std::is_integral_v<TValue> && sizeof(TValue) == 4)
+			{
+				Xoshiro256PlusPlusX8(stream).FillInts(std::ranges::data(range), size, min, max);
+				return;
+			}
+			else if constexpr(std::is_floating_point_v<TValue>)
+			{
+				Xoshiro256PlusPlusX8(stream).FillReals(std::ranges::data(range), size, min, max);
+				return;
+			}
+			else if(min == std::numeric_limits<TValue>::min() && max == std::numeric_limits<TValue>::max())
+			{
+				Xoshiro256PlusPlusX8(stream).FillBytes(reinterpret_cast<std::byte*>(std::ranges::data(range)), size * sizeof(TValue));
+				return;
+			}
+		}
+
+		Xoshiro256PlusPlus engine(stream);
+		PackedFiller::Fill(range, min, max, engine);
+	}
+
+	/// <summary>
+	/// Fill a chunk of ParallelFill with numbers in a range [0, 1) from its stream only
+	/// </summary>
+	template<typename TRange>
+	static void FillFrom(const Xoshiro256PlusPlus& stream, TRange&& range) noexcept
+	{
+		if constexpr(std::ranges::contiguous_range<TRange> && std::ranges::sized_range<TRange> &&
+					 std::is_floating_point_v<std::ranges::range_value_t<TRange>>)
+		{
+			Xoshiro256PlusPlusX8(stream).FillReals(std::ranges::data(range), std::ranges::size(range), 0.0, 1.0);
+		}
+		else
+		{
+			Xoshiro256PlusPlus engine(stream);
+			PackedFiller::FillUnit(range, engine);
+		}
+	}
+
+	/// <summary>
+	/// MergeShuffle by A. Bacher, O. Bodini, A. Hollender and J. Lumbroso. Blocks of
+	/// ParallelChunkSize elements are shuffled in parallel, then neighbouring blocks are merged
+	/// level by level with one coin flip per element. Every block and every merge takes
+	/// its own stream, so the result depends on the seed only.
+	/// </summary>
+	template<typename TRange>
+	static void ParallelShuffleBlocks(TRange&& range, std::uint64_t seed, unsigned threadCount)
+	{
+		const std::size_t size = std::ranges::size(range);
+		const std::size_t blocks = (size + ParallelChunkSize - 1) / ParallelChunkSize;
+		auto streams = ParallelRunner::MakeStreams(seed, blocks > 0 ? 2 * blocks - 1 : 0);
+		const auto begin = std::ranges::begin(range);
+		std::size_t task = blocks;
+
+		ParallelRunner::Run(blocks, threadCount, [&](std::size_t block)
+		{
+			const std::size_t first = block * ParallelChunkSize;
+			const std::size_t last = std::min(size, first + ParallelChunkSize);
+
+			std::ranges::shuffle(begin + first, begin + last, streams[block]);
+		});
+
+		for(std::size_t width = ParallelChunkSize; width < size; width *= 2)
+		{
+			const std::size_t merges = (size + width - 1) / width / 2;
+
+			ParallelRunner::Run(merges, threadCount, [&](std::size_t merge)
+			{
+				const std::size_t first = merge * 2 * width;
+				const std::size_t last = std::min(size, first + 2 * width);
+
+				Merge(begin + first, begin + first + width, begin + last, streams[task + merge]);
+			});
+
+			task += merges;
+		}
+	}
+
+	/// <summary>
+	/// Merge two shuffled neighbouring ranges into one shuffled range
+	/// </summary>
+	template<typename TIterator>
+	static void Merge(TIterator first, TIterator middle, TIterator last, Xoshiro256PlusPlus& engine) noexcept
+	{
+		TIterator left = first, right = middle;
+		std::uint64_t bits = 0;
+		int available = 0;
+
+		while(true)
+		{
+			if(available == 0)
+			{
+				bits = engine();
+				available = 64;
+			}
+
+			const bool takeRight = bits & 1;
+
+			bits >>= 1;
+			available--;
+
+			if(takeRight)
+			{
+				if(right == last)
+				{
+					break;
+				}
+
+				std::ranges::iter_swap(left, right);
+				++right;
+			}
+			else if(left == right)
+			{
+				break;
+			}
+
+			++left;
+		}
+
+		// One of the ranges is exhausted, insert the rest as Fisher-Yates does
+		for(; left != last; ++left)
+		{
+			const auto index = BoundedSampler<std::size_t>::Next(engine, 0, static_cast<std::size_t>(left - first));
+			std::ranges::iter_swap(first + index, left);
+		}
+	}
+
+	/// <summary>
+	/// Scatter shuffle of P. Sanders, "Random permutations on distributed, external and hierarchical memory".
+	/// Every element takes an independent uniform bucket label, the buckets are written out of place
+	/// as a few sequential streams and then shuffled one by one in the cache, which gives a uniform permutation.
+	/// Labels are counted and then scattered by replaying the same streams, so they are never stored.
+	/// Chunks and buckets take their own streams, so the result depends on the seed only.
+	/// </summary>
+	template<typename TRange>
+	static void CacheAwareShuffleBuckets(TRange&& range, std::uint64_t seed, unsigned threadCount) noexcept
+	{
+		using TValue = std::ranges::range_value_t<TRange>;
+		constexpr std::size_t MaxChunks = 256;
+
+		const std::size_t size = std::ranges::size(range);
+		const std::size_t bucketSize = std::max<std::size_t>(1, ShuffleBucketBytes / sizeof(TValue));
+		const auto first = std::ranges::begin(range);
+
+		if(size <= bucketSize)
+		{
+			Xoshiro256PlusPlus engine(seed);
+			std::ranges::shuffle(first, first + size, engine);
+			return;
+		}
+
+		std::unique_ptr<TValue[]> buffer(new(std::nothrow) TValue[size]);
+
+		if(!buffer)
+		{
+			Xoshiro256PlusPlus engine(seed);
+			std::ranges::shuffle(first, first + size, engine);
+			return;
+		}
+
+		const int labelBits = std::min(std::bit_width(MaxShuffleBuckets - 1), std::bit_width((size - 1) / bucketSize));
+		const std::size_t buckets = std::size_t(1) << labelBits;
+		const std::size_t chunkSize = std::max(ParallelChunkSize, (size + MaxChunks - 1) / MaxChunks);
+		const std::size_t chunks = (size + chunkSize - 1) / chunkSize;
+		std::vector<Xoshiro256PlusPlus> streams;
+		std::vector<std::size_t> offsets;
+		std::vector<std::size_t> bucketStarts;
+
+		try
+		{
+			streams = ParallelRunner::MakeStreams(seed, chunks + buckets);
+			offsets.resize(chunks * buckets);
+			bucketStarts.resize(buckets + 1);
+		}
+		catch(const std::bad_alloc&)
+		{
+			buffer.reset();
+
+			Xoshiro256PlusPlus engine(seed);
+			std::ranges::shuffle(first, first + size, engine);
+			return;
+		}
+
+		// Call visit(index, label) for every element of the chunk
+		const auto forEachLabel = [&](std::size_t chunk, auto&& visit)
+		{
+			Xoshiro256PlusPlus engine = streams[chunk];
+			const std::size_t last = std::min(size, (chunk + 1) * chunkSize);
+			std::uint64_t bits = 0;
+			int available = 0;
+
+			for(std::size_t i = chunk * chunkSize; i < last; i++)
+			{
+				if(available == 0)
+				{
+					bits = engine();
+					available = 64 / labelBits;
+				}
+
+				visit(i, static_cast<std::size_t>(bits & (buckets - 1)));
+				bits >>= labelBits;
+				available--;
+			}
+		};
+
+		ParallelRunner::Run(chunks, threadCount, [&](std::size_t chunk)
+		{
+			std::size_t* counts = offsets.data() + chunk * buckets;
+
+			forEachLabel(chunk, [counts](std::size_t, std::size_t label) { counts[label]++; });
+		});
+
+		// Bucket by bucket, chunk by chunk, so that the chunks write each bucket in turn
+		for(std::size_t bucket = 0, offset = 0; bucket < buckets; bucket++)
+		{
+			bucketStarts[bucket] = offset;
+
+			for(std::size_t chunk = 0; chunk < chunks; chunk++)
+			{
+				offset += std::exchange(offsets[chunk * buckets + bucket], offset);
+			}
+		}
+
+		bucketStarts[buckets] = size;
+
+		ParallelRunner::Run(chunks, threadCount, [&](std::size_t chunk)
+		{
+			std::size_t* positions = offsets.data() + chunk * buckets;
+
+			forEachLabel(chunk, [&](std::size_t index, std::size_t label)
+			{
+				buffer[positions[label]++] = std::move(first[index]);
+			});
+		});
+
+		ParallelRunner::Run(buckets, threadCount, [&](std::size_t bucket)
+		{
+			const std::size_t begin = bucketStarts[bucket];
+			const std::size_t end = bucketStarts[bucket + 1];
+			Xoshiro256PlusPlus engine = streams[chunks + bucket];
+
+			std::move(buffer.get() + begin, buffer.get() + end, first + begin);
+
+			if(end - begin > bucketSize)
+			{
+				CacheAwareShuffleBuckets(std::ranges::subrange(first + begin, first + end), engine(), 1);
+			}
+			else
+			{
+				std::ranges::shuffle(first + begin, first + end, engine);
+			}
+		});
+	}
+
+	template<typename TRange, typename TOutput>
+	static TOutput SampleWithReplacementSeeded(std::uint64_t seed, TRange& range, std::size_t count, TOutput output) noexcept
+	{
+		const std::size_t size = static_cast<std::size_t>(std::ranges::size(range));
+
+		if(size == 0)
+		{
+			return output;
+		}
+
+		const auto first = std::ranges::begin(range);
+		bool prefetch = false;
+
+		if constexpr(std::ranges::contiguous_range<TRange>)
+		{
+			prefetch = size >= SamplePrefetchBytes / sizeof(std::ranges::range_value_t<TRange>);
+		}
+
+		// Reads of a large source miss the cache, so the element PrefetchDistance indices ahead is requested early
+		const auto gather = [&](const auto* indices, std::size_t batch)
+		{
+			std::size_t i = 0;
+
+			if constexpr(std::ranges::contiguous_range<TRange>)
+			{
+				if(prefetch && batch > SamplePrefetchDistance)
+				{
+					const auto data = std::ranges::data(range);
+
+					for(; i < batch - SamplePrefetchDistance; i++)
+					{
+						RANDOM_PREFETCH(data + indices[i + SamplePrefetchDistance]);
+						*output = data[indices[i]];
+						++output;
+					}
+				}
+			}
+
+			for(; i < batch; i++)
+			{
+				*output = first[static_cast<std::ranges::range_difference_t<TRange>>(indices[i])];
+				++output;
+			}
+		};
+
+		if(size - 1 <= std::numeric_limits<std::uint32_t>::max())
+		{
+			Xoshiro256PlusPlusX8 generator(seed);
+			std::uint32_t indices[SampleBatchSize];
+
+			for(; count > 0; count -= std::min(count, SampleBatchSize))
+			{
+				const std::size_t batch = std::min(count, SampleBatchSize);
+
+				generator.FillInts(indices, batch, std::uint32_t(0), static_cast<std::uint32_t>(size - 1));
+				gather(indices, batch);
+			}
+		}
+		else
+		{
+			BufferedEngine<Xoshiro256PlusPlusX8> engine(seed);
+			const BoundedSampler<std::uint64_t> sampler(0, size - 1);
+			std::uint64_t indices[SampleBatchSize];
+
+			for(; count > 0; count -= std::min(count, SampleBatchSize))
+			{
+				const std::size_t batch = std::min(count, SampleBatchSize);
+
+				for(std::size_t i = 0; i < batch; i++)
+				{
+					indices[i] = sampler(engine);
+				}
+
+				gather(indices, batch);
+			}
+		}
+
+		return output;
+	}
+
+	template<typename TFillBytes, typename TWrite>
+	static bool WriteBytesFrom(TFillBytes&& fillBytes, std::uint64_t size, TWrite& write) noexcept
+	{
+		std::unique_ptr<std::byte[]> chunk(new(std::nothrow) std::byte[static_cast<std::size_t>(std::min<std::uint64_t>(size, WriteChunkSize))]);
+
+		if(!chunk)
+		{
+			return false;
+		}
+
+		while(size > 0)
+		{
+			const std::size_t count = static_cast<std::size_t>(std::min<std::uint64_t>(size, WriteChunkSize));
+			const std::span<const std::byte> bytes(chunk.get(), count);
+
+			fillBytes(chunk.get(), count);
+			size -= count;
+
+			if constexpr(std::is_convertible_v<std::invoke_result_t<TWrite&, std::span<const std::byte>>, bool>)
+			{
+				if(!write(bytes))
+				{
+					return false;
+				}
+			}
+			else
+			{
+				write(bytes);
+			}
+		}
+
+		return true;
+	}
+
+	/// <summary>
+	/// Make a child generator of a seed taken from the parent. The seed is mixed by SplitMix64,
+	/// so the child is not the parent stream shifted by one output, as it would be for a linear congruential engine.
+	/// </summary>
+	static BasicRandom MakeChild(std::uint64_t seed) noexcept requires IsSplittableEngine<TEngine>
+	{
+		SplitMix64 expander(seed);
+
+		if constexpr(std::constructible_from<TEngine, std::seed_seq&>)
+		{
+			const std::uint64_t low = expander(), high = expander();
+			std::seed_seq sequence
+			{
+				static_cast<std::uint32_t>(low), static_cast<std::uint32_t>(low >> 32),
+				static_cast<std::uint32_t>(high), static_cast<std::uint32_t>(high >> 32)
+			};
+
+			return BasicRandom(TEngine(sequence));
+		}
+		else
+		{
+			return BasicRandom(TEngine(static_cast<typename TEngine::result_type>(expander())));
+		}
+	}
+
+	/// <summary>
+	/// Random number in a range (0, 1]
+	/// </summary>
+	double NextOpenUnit() noexcept
+	{
+		return 1.0 - RandomBits::ToDouble(RandomBits::Next64(_engine));
+	}
+public:
+	using Engine = TEngine;
+
+	/// <summary>
+	/// Number of elements processed as one task by the parallel algorithms
+	/// </summary>
+	static constexpr std::size_t ParallelChunkSize = std::size_t(1) << 18;
+
+	/// <summary>
+	/// Size of the chunks passed to the writer of WriteBytes
+	/// </summary>
+	static constexpr std::size_t WriteChunkSize = std::size_t(1) << 20;
+
+	/// <summary>
+	/// Bytes of one bucket of the cache-aware shuffle, about the size of a level 2 cache
+	/// </summary>
+	static constexpr std::size_t ShuffleBucketBytes = std::size_t(1) << 18;
+
+	/// <summary>
+	/// Maximum number of buckets of one scatter pass, larger buckets are scattered again
+	/// </summary>
+	static constexpr std::size_t MaxShuffleBuckets = 1024;
+
+	/// <summary>
+	/// Number of indices drawn at once by SampleWithReplacement, they stay in the level 1 cache
+	/// </summary>
+	static constexpr std::size_t SampleBatchSize = 256;
+
+	/// <summary>
+	/// Bytes of a contiguous source from which SampleWithReplacement prefetches the elements, about the size of a level 2 cache
+	/// </summary>
+	static constexpr std::size_t SamplePrefetchBytes = std::size_t(1) << 20;
+
+	/// <summary>
+	/// How many indices ahead SampleWithReplacement prefetches, enough to keep the loads of a core in flight
+	/// </summary>
+	static constexpr std::size_t SamplePrefetchDistance = 16;
+
+	/// <summary>
+	/// Seed the engine with the next seed of the process-wide SeedSource
+	/// </summary>
+	BasicRandom() noexcept requires (!std::is_empty_v<TEngine>):
+		_engine(static_cast<typename TEngine::result_type>(SeedSource::Next()))
+	{}
+
+	/// <summary>
+	/// Default-construct an empty engine. Such engines, like ThreadLocalEngine and NumaPoolEngine,
+	/// are handles to process-wide state that their seeding constructors reseed for every thread.
+	/// </summary>
+	BasicRandom() noexcept requires std::is_empty_v<TEngine>:
+		_engine()
+	{}
+
+	BasicRandom(unsigned int seed) noexcept:
+		_engine(seed)
+	{}
+
+	/// <summary>
+	/// Use a copy of the engine
+	/// </summary>
+	/// <param name="engine"> - engine in any state</param>
+	explicit BasicRandom(const TEngine& engine) noexcept:
+		_engine(engine)
+	{}
+
+	/// <summary>
+	/// Take a binary image of the engine, a copy of sizeof(TEngine) bytes
+	/// </summary>
+	/// <returns>the state to restore with LoadState</returns>
+	RandomState<TEngine> SaveState() const noexcept requires IsSerializableEngine<TEngine>
+	{
+		RandomState<TEngine> state;
+
+		std::memcpy(state.Engine, &_engine, sizeof(TEngine));
+		return state;
+	}
+
+	/// <summary>
+	/// Restore the engine from a binary image made by SaveState
+	/// </summary>
+	/// <param name="state"> - state of the engine</param>
+	/// <returns>false, and the engine is unchanged, if the image is of another engine</returns>
+	bool LoadState(const RandomState<TEngine>& state) noexcept requires IsSerializableEngine<TEngine>
+	{
+		if(!state.IsValid())
+		{
+			return false;
+		}
+
+		std::memcpy(&_engine, state.Engine, sizeof(TEngine));
+		return true;
+	}
+
+	/// <summary>
+	/// Restore the engine from the bytes of a RandomState, such as a region of a mapped file
+	/// </summary>
+	/// <param name="bytes"> - sizeof(RandomState) bytes, need not be aligned</param>
+	/// <returns>false, and the engine is unchanged, if the bytes are not a state of this engine</returns>
+	bool LoadState(std::span<const std::byte> bytes) noexcept requires IsSerializableEngine<TEngine>
+	{
+		RandomState<TEngine> state;
+
+		if(bytes.size() != sizeof(state))
+		{
+			return false;
+		}
+
+		std::memcpy(&state, bytes.data(), sizeof(state));
+		return LoadState(state);
+	}
+
+	/// <summary>
+	/// Derive an independent child generator in O(1), as SplittableRandom does. The parent advances by one output,
+	/// so a task that splits its generator in a fixed order gets the same children however tasks are scheduled.
+	/// </summary>
+	/// <returns>a generator to pass to a subtask by value</returns>
+	BasicRandom Split() noexcept requires IsSplittableEngine<TEngine>
+	{
+		return MakeChild(RandomBits::Next64(_engine));
+	}
+
+	/// <summary>
+	/// Compute an element of a stream of a counter-based engine without changing the generator
+	/// </summary>
+	/// <param name="stream"> - stream number</param>
+	/// <param name="index"> - index of the element</param>
+	/// <returns>64 random bits</returns>
+	std::uint64_t At(std::uint64_t stream, std::uint64_t index) const noexcept requires IsCounterBasedEngine<TEngine>
+	{
+		return _engine.At(stream, index);
+	}
+
+	/// <summary>
+	/// Move a counter-based engine to an element of a stream in O(1) time
+	/// </summary>
+	/// <param name="stream"> - stream number</param>
+	/// <param name="index"> - index of the next element</param>
+	void Seek(std::uint64_t stream, std::uint64_t index) noexcept requires IsCounterBasedEngine<TEngine>
+	{
+		_engine.Seek(stream, index);
+	}
+
+	/// <summary>
+	/// Fill a numeric range with the elements of the current stream of a counter-based engine starting from offset,
+	/// without changing the generator. Independent slices of one global range are filled by passing their first index.
+	/// </summary>
+	/// <param name="range"> - numeric range</param>
+	/// <param name="offset"> - index of the first element</param>
+	template<typename TRange> requires IsArithmeticRange<TRange> && IsCounterBasedEngine<TEngine>
+	void Fill(TRange&& range, std::uint64_t offset) const noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::Fill);
+
+		_engine.Fill(std::forward<TRange>(range), offset);
+	}
+
+	/// <summary>
+	/// Generate a random unsigned int number in a range [0, max]
+	/// </summary>
+	/// <param name="max"> - maximum value</param>
+	/// <returns>a random unsigned int number in a range [0, max]</returns>
+	unsigned int Next(unsigned int max) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::Next);
+
+		return BoundedSampler<unsigned int>::Next(_engine, 0, max);
+	}
+
+	/// <summary>
+	/// Generate a random int number in a range [min, max]
+	/// </summary>
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	/// <returns>a random number in a range [min, max]</returns>
+	int NextInt(int min, int max) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::NextInt);
+
+		return BoundedSampler<int>::Next(_engine, min, max);
+	}
+
+	/// <summary>
+	/// Generate a random int64 number in a range [min, max]
+	/// </summary>
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	/// <returns>a random number in a range [min, max]</returns>
+	std::int64_t NextInt64(std::int64_t min, std::int64_t max) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::NextInt64);
+
+		return BoundedSampler<std::int64_t>::Next(_engine, min, max);
+	}
+
+	/// <summary>
+	/// Generate a random number in the range of a sampler
+	/// </summary>
+	/// <param name="sampler"> - sampler made by MakeBoundedSampler</param>
+	/// <returns>a random number in a range [sampler.Min(), sampler.Max()]</returns>
+	template<typename TInt>
+	TInt Next(const BoundedSampler<TInt>& sampler) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::NextBounded);
+
+		return sampler(_engine);
+	}
+
+	/// <summary>
+	/// Make a sampler with precomputed parameters for a fixed range [min, max]
+	/// </summary>
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	/// <returns>a sampler for Next(sampler)</returns>
+	template<typename TInt> requires std::is_integral_v<TInt>
+	static BoundedSampler<TInt> MakeBoundedSampler(TInt min, TInt max) noexcept
+	{
+		return BoundedSampler<TInt>(min, max);
+	}
+
+	/// <summary>
+	/// Generate a random index with probability proportional to its weight
+	/// </summary>
+	/// <param name="sampler"> - sampler made by MakeWeightedSampler</param>
+	/// <returns>a random index in a range [0, sampler.Size())</returns>
+	std::size_t Next(const WeightedSampler& sampler) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::NextWeighted);
+
+		return sampler(_engine);
+	}
+
+	/// <summary>
+	/// Make an alias table for choosing indices by weight in O(1)
+	/// </summary>
+	/// <param name="weights"> - non-negative weights, at least one of them is positive</param>
+	/// <returns>a sampler for Next(sampler)</returns>
+	/// <exception cref="std::invalid_argument">if no weight is positive</exception>
+	template<typename TRange> requires IsArithmeticRange<TRange>
+	static WeightedSampler MakeWeightedSampler(TRange&& weights)
+	{
+		return WeightedSampler(std::forward<TRange>(weights));
+	}
+
+	/// <summary>
+	/// Generate a random real number in a range [min, max)
+	/// </summary>
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	/// <returns>a random real number in a range [min, max)</returns>
+	double NextDouble(double min, double max) noexcept
+	{
+		return std::min(min + (max - min) * NextDouble(), RandomBits::UpperBound(min, max));
+	}
+
+	/// <summary>
+	/// Generate a random real number in a range [0, 1) from a single 64-bit output
+	/// </summary>
+	/// <returns>a random real number in a range [0, 1)</returns>
+	double NextDouble() noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::NextDouble);
+
+		return RandomBits::ToDouble(RandomBits::Next64(_engine));
+	}
+
+	/// <summary>
+	/// Generate a random float number in a range [min, max)
+	/// </summary>
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	/// <returns>a random float number in a range [min, max)</returns>
+	float NextFloat(float min, float max) noexcept
+	{
+		return std::min(min + (max - min) * NextFloat(), RandomBits::UpperBound(min, max));
+	}
+
+	/// <summary>
+	/// Generate a random float number in a range [0, 1) from 24 random bits
+	/// </summary>
+	/// <returns>a random float number in a range [0, 1)</returns>
+	float NextFloat() noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::NextFloat);
+
+		return RandomBits::ToFloat(RandomBits::Next32(_engine));
+	}
+
+	/// <summary>
+	/// Generate a normally distributed random number with the ziggurat method
+	/// </summary>
+	/// <returns>a random number with mean 0 and deviation 1</returns>
+	double NextNormal() noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::NextNormal);
+
+		return Ziggurat::Normal(_engine);
+	}
+
+	/// <summary>
+	/// Generate a normally distributed random number with the ziggurat method
+	/// </summary>
+	/// <param name="mean"> - mean</param>
+	/// <param name="deviation"> - standard deviation</param>
+	/// <returns>a random number with the given mean and deviation</returns>
+	double NextNormal(double mean, double deviation) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::NextNormal);
+
+		return mean + deviation * Ziggurat::Normal(_engine);
+	}
+
+	/// <summary>
+	/// Generate an exponentially distributed random number with the ziggurat method
+	/// </summary>
+	/// <returns>a random number with rate 1</returns>
+	double NextExponential() noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::NextExponential);
+
+		return Ziggurat::Exponential(_engine);
+	}
+
+	/// <summary>
+	/// Generate an exponentially distributed random number with the ziggurat method
+	/// </summary>
+	/// <param name="rate"> - rate, the inverse of the mean</param>
+	/// <returns>a random number with the given rate</returns>
+	double NextExponential(double rate) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::NextExponential);
+
+		return Ziggurat::Exponential(_engine) / rate;
+	}
+
+	/// <summary>
+	/// Generate a Poisson distributed random number.
+	/// Make a PoissonDistribution to draw many numbers with the same mean.
+	/// </summary>
+	/// <param name="mean"> - mean, not negative</param>
+	/// <returns>a random number of events</returns>
+	std::uint64_t NextPoisson(double mean) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::NextPoisson);
+
+		return PoissonDistribution(mean)(_engine);
+	}
+
+	/// <summary>
+	/// Generate a random number of a distribution
+	/// </summary>
+	/// <param name="distribution"> - distribution such as NormalDistribution</param>
+	/// <returns>a random number</returns>
+	template<typename TDistribution> requires IsDistribution<TDistribution>
+	auto Next(const TDistribution& distribution) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::NextDistribution);
+
+		return distribution(_engine);
+	}
+
+	/// <summary>
+	/// Fill a numeric range with random numbers of a distribution.
+	/// Large contiguous ranges draw the raw bits in vectorized blocks, and the distributions
+	/// with a Fill(output, count, engine) member such as NormalDistribution process them block by block.
+	/// </summary>
+	/// <param name="range"> - numeric range</param>
+	/// <param name="distribution"> - distribution such as NormalDistribution</param>
+	template<typename TRange, typename TDistribution> requires IsArithmeticRange<TRange> && IsDistribution<TDistribution>
+	void Fill(TRange&& range, const TDistribution& distribution) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::Fill);
+
+		using TValue = std::ranges::range_value_t<TRange>;
+
+		if constexpr(std::ranges::contiguous_range<TRange> && std::ranges::sized_range<TRange> && !IsCounterBasedEngine<TEngine>)
+		{
+			// Smaller ranges would not use the most of a block
+			if(std::ranges::size(range) >= BufferedEngine<Xoshiro256PlusPlusX8>::BlockSize)
+			{
+				auto&& generator = BulkGenerator();
+				BufferedEngine<Xoshiro256PlusPlusX8> engine(generator);
+
+				if constexpr(requires { distribution.Fill(std::ranges::data(range), std::ranges::size(range), engine); })
+				{
+					distribution.Fill(std::ranges::data(range), std::ranges::size(range), engine);
+				}
+				else
+				{
+					for(auto& item : range)
+					{
+						item = static_cast<TValue>(distribution(engine));
+					}
+				}
+
+				generator = engine.Engine();
+				return;
+			}
+		}
+
+		for(auto& item : range)
+		{
+			item = static_cast<TValue>(distribution(_engine));
+		}
+	}
+
+	/// <summary>
+	/// Fill a numeric range with random numbers of its element type: integers in a range [min, max],
+	/// real numbers in a range [min, max). Values are generated in their own width, small types
+	/// share engine outputs and 64-bit integers reach their full range. With a counter-based engine
+	/// contiguous real and full-range integer ranges are its next elements, min + (max - min) * element for reals.
+	/// </summary>
+	/// <param name="range"> - numeric range</param>
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	template<typename TRange> requires IsArithmeticRange<TRange>
+	void Fill(TRange&& range, std::ranges::range_value_t<TRange> min, std::ranges::range_value_t<TRange> max) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::Fill);
+
+		using TValue = std::ranges::range_value_t<TRange>;
+
+		if constexpr(std::ranges::contiguous_range<TRange> && std::ranges::sized_range<TRange> && !std::is_same_v<TValue, bool> &&
+					 IsCounterBasedEngine<TEngine>)
+		{
+			if constexpr(std::is_floating_point_v<TValue>)
+			{
+				const TValue scale = max - min;
+				const TValue bound = RandomBits::UpperBound(min, max);
+
+				FillElements(range);
+
+				for(auto& item : range)
+				{
+					item = std::min(min + scale * item, bound);
+				}
+
+				return;
+			}
+			else if(min == std::numeric_limits<TValue>::min() && max == std::numeric_limits<TValue>::max())
+			{
+				FillElements(range);
+				return;
+			}
+		}
+		else if constexpr(std::ranges::contiguous_range<TRange> && std::ranges::sized_range<TRange> && !std::is_same_v<TValue, bool>)
+		{
+			const std::size_t size = std::ranges::size(range);
+
+			if(size >= Xoshiro256PlusPlusX8::MinBulkSize)
+			{
+				if constexpr(std::is_integral_v<TValue> && sizeof(TValue) == 4)
+				{
+					BulkGenerator().FillInts(std::ranges::data(range), size, min, max);
+					return;
+				}
+				else if constexpr(std::is_floating_point_v<TValue>)
+				{
+					BulkGenerator().FillReals(std::ranges::data(range), size, min, max);
+					return;
+				}
+				else if(min == std::numeric_limits<TValue>::min() && max == std::numeric_limits<TValue>::max())
+				{
+					BulkGenerator().FillBytes(reinterpret_cast<std::byte*>(std::ranges::data(range)), size * sizeof(TValue));
+					return;
+				}
+			}
+		}
+
+		if constexpr(std::ranges::sized_range<TRange> && !IsCounterBasedEngine<TEngine>)
+		{
+			if(std::ranges::size(range) >= BufferedEngine<Xoshiro256PlusPlusX8>::BlockSize)
+			{
+				auto&& generator = BulkGenerator();
+				BufferedEngine<Xoshiro256PlusPlusX8> engine(generator);
+				PackedFiller::Fill(range, min, max, engine);
+				generator = engine.Engine();
+				return;
+			}
+		}
+
+		PackedFiller::Fill(range, min, max, _engine);
+	}
+
+	/// <summary>
+	/// Fill a span with random int numbers in a range [min, max]
+	/// </summary>
+	/// <param name="values"> - output</param>
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	void NextInts(std::span<int> values, int min, int max) noexcept
+	{
+		Fill(values, min, max);
+	}
+
+	/// <summary>
+	/// Fill a span with random double numbers in a range [min, max)
+	/// </summary>
+	/// <param name="values"> - output</param>
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	void NextDoubles(std::span<double> values, double min, double max) noexcept
+	{
+		Fill(values, min, max);
+	}
+
+	/// <summary>
+	/// Fill a numeric range with random numbers in a range [0, 1).
+	/// Float ranges take 24 random bits per number, so they never round up to 1.
+	/// With a counter-based engine contiguous ranges are its next elements, as its Fill(range, offset) gives them.
+	/// </summary>
+	/// <param name="range"> - numeric range</param>
+	template<typename TRange> requires IsArithmeticRange<TRange>
+	void Fill(TRange&& range) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::Fill);
+
+		using TValue = std::ranges::range_value_t<TRange>;
+
+		if constexpr(std::ranges::contiguous_range<TRange> && std::ranges::sized_range<TRange> &&
+					 std::is_floating_point_v<TValue> && IsCounterBasedEngine<TEngine>)
+		{
+			FillElements(range);
+			return;
+		}
+		else if constexpr(std::ranges::contiguous_range<TRange> && std::ranges::sized_range<TRange> &&
+						  std::is_floating_point_v<TValue>)
+		{
+			if(std::ranges::size(range) >= Xoshiro256PlusPlusX8::MinBulkSize)
+			{
+				BulkGenerator().FillReals(std::ranges::data(range), std::ranges::size(range), 0.0, 1.0);
+				return;
+			}
+		}
+
+		PackedFiller::FillUnit(range, _engine);
+	}
+
+	/// <summary>
+	/// Fill memory with raw random bits. Large buffers are filled by the vectorized kernel
+	/// at the speed of memory, so a memory-mapped file can be filled in place without copies.
+	/// </summary>
+	/// <param name="bytes"> - memory to fill</param>
+	void FillBytes(std::span<std::byte> bytes) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::FillBytes);
+
+		if constexpr(!IsCounterBasedEngine<TEngine>)
+		{
+			if(bytes.size() >= Xoshiro256PlusPlusX8::MinBulkSize * sizeof(std::uint64_t))
+			{
+				BulkGenerator().FillBytes(bytes.data(), bytes.size());
+				return;
+			}
+		}
+
+		FillEngineBytes(bytes.data(), bytes.size());
+	}
+
+	/// <summary>
+	/// Fill several buffers with raw random bits, like an iovec for writev
+	/// </summary>
+	/// <param name="buffers"> - memory to fill</param>
+	void FillBytes(std::span<const std::span<std::byte>> buffers) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::FillBytes);
+
+		if constexpr(IsCounterBasedEngine<TEngine>)
+		{
+			for(const auto& buffer : buffers)
+			{
+				FillEngineBytes(buffer.data(), buffer.size());
+			}
+		}
+		else
+		{
+			auto&& generator = BulkGenerator();
+
+			for(const auto& buffer : buffers)
+			{
+				generator.FillBytes(buffer.data(), buffer.size());
+			}
+		}
+	}
+
+	/// <summary>
+	/// Fill a buffer with random characters of an alphabet, several characters per engine output
+	/// </summary>
+	/// <param name="output"> - buffer to fill</param>
+	/// <param name="alphabet"> - characters to choose from, with equal probabilities</param>
+	/// <returns>false if the alphabet is empty, the buffer is unchanged then</returns>
+	bool FillChars(std::span<char> output, std::string_view alphabet) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::FillChars);
+
+		return CharFiller::Fill(output, alphabet, _engine);
+	}
+
+	/// <summary>
+	/// Fill a buffer with random lowercase hexadecimal digits, 16 per engine output
+	/// </summary>
+	/// <param name="output"> - buffer to fill</param>
+	void FillHex(std::span<char> output) noexcept
+	{
+		FillChars(output, CharFiller::HexDigits);
+	}
+
+	/// <summary>
+	/// Fill a buffer with random characters of the URL-safe base64 alphabet, 10 per engine output
+	/// </summary>
+	/// <param name="output"> - buffer to fill</param>
+	void FillBase64Url(std::span<char> output) noexcept
+	{
+		FillChars(output, CharFiller::Base64UrlDigits);
+	}
+
+	/// <summary>
+	/// Generate a random string of an alphabet
+	/// </summary>
+	/// <param name="length"> - number of characters</param>
+	/// <param name="alphabet"> - characters to choose from, with equal probabilities</param>
+	/// <returns>the string, empty if the alphabet is empty</returns>
+	std::string NextString(std::size_t length, std::string_view alphabet)
+	{
+		std::string result(alphabet.empty() ? 0 : length, '\0');
+
+		FillChars(result, alphabet);
+		return result;
+	}
+
+	/// <summary>
+	/// Write a random version 4 UUID as 36 lowercase characters
+	/// </summary>
+	/// <param name="output"> - buffer of 36 characters</param>
+	void FillUuid(std::span<char, 36> output) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::FillChars);
+
+		CharFiller::FillUuid(output, _engine);
+	}
+
+	/// <summary>
+	/// Generate a random version 4 UUID without allocation
+	/// </summary>
+	/// <returns>36 lowercase characters, not terminated by zero</returns>
+	std::array<char, 36> NextUuid() noexcept
+	{
+		std::array<char, 36> result;
+
+		FillUuid(result);
+		return result;
+	}
+
+	/// <summary>
+	/// Stream raw random bits to a writer in chunks of WriteChunkSize bytes.
+	/// One chunk of memory is reused, so the size of the output is unlimited.
+	/// </summary>
+	/// <param name="size"> - number of bytes</param>
+	/// <param name="write"> - called with every chunk, may return false to stop</param>
+	/// <returns>false if the writer stopped or the chunk could not be allocated</returns>
+	template<typename TWrite> requires std::invocable<TWrite&, std::span<const std::byte>>
+	bool WriteBytes(std::uint64_t size, TWrite&& write) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::WriteBytes);
+
+		if constexpr(IsCounterBasedEngine<TEngine>)
+		{
+			return WriteBytesFrom([this](std::byte* data, std::size_t count) { FillEngineBytes(data, count); }, size, write);
+		}
+		else
+		{
+			auto&& generator = BulkGenerator();
+			return WriteBytesFrom([&generator](std::byte* data, std::size_t count) { generator.FillBytes(data, count); }, size, write);
+		}
+	}
+
+	/// <summary>
+	/// Reorders the elements in the given range such
+	/// that each possible permutation of those elements has equal probability of appearance.
+	/// </summary>
+	/// <param name="range"> - 	the range of elements to shuffle randomly</param>
+	template<typename TRange> requires std::ranges::random_access_range<TRange>
+	void Shuffle(TRange&& range) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::Shuffle);
+
+		std::ranges::shuffle(std::forward<TRange>(range), _engine);
+	}
+
+	/// <summary>
+	/// Shuffle a range larger than the cache: each permutation has equal probability of appearance,
+	/// but the elements are moved as sequential streams instead of one cache miss per element.
+	/// Takes a temporary buffer of the size of the range, and falls back to Fisher-Yates if it cannot be allocated.
+	/// The result depends on the state of the generator only, not on the number of threads.
+	/// </summary>
+	/// <param name="range"> - the range of elements to shuffle randomly</param>
+	/// <param name="mode"> - the number of threads</param>
+	template<typename TRange> requires std::ranges::random_access_range<TRange> && std::ranges::sized_range<TRange> &&
+									   std::default_initializable<std::ranges::range_value_t<TRange>> &&
+									   std::movable<std::ranges::range_value_t<TRange>>
+	void Shuffle(TRange&& range, CacheAwareShuffle mode) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::Shuffle);
+
+		CacheAwareShuffleBuckets(range, RandomBits::Next64(_engine), mode.ThreadCount);
+	}
+
+	/// <summary>
+	/// Place a random k-permutation of the elements to the beginning of the range with only k swaps.
+	/// The rest of the range holds the other elements in unspecified order.
+	/// </summary>
+	/// <param name="range"> - the range of elements</param>
+	/// <param name="count"> - number of elements to shuffle to the beginning</param>
+	template<typename TRange> requires std::ranges::random_access_range<TRange> && std::ranges::sized_range<TRange>
+	void PartialShuffle(TRange&& range, std::size_t count) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::PartialShuffle);
+
+		const std::size_t size = std::ranges::size(range);
+		const auto first = std::ranges::begin(range);
+
+		count = std::min(count, size);
+
+		for(std::size_t i = 0; i < count; i++)
+		{
+			const std::size_t index = BoundedSampler<std::size_t>::Next(_engine, i, size - 1);
+			std::ranges::iter_swap(first + i, first + index);
+		}
+	}
+
+	/// <summary>
+	/// Generate count distinct random indices in a range [0, size) in random order.
+	/// When count is much less than size, Floyd's algorithm takes O(count) time and memory,
+	/// otherwise the first count elements of a partially shuffled array of all indices are taken.
+	/// </summary>
+	/// <param name="size"> - number of indices to choose from</param>
+	/// <param name="count"> - number of indices to choose, at most size</param>
+	/// <returns>a random k-permutation of a range [0, size)</returns>
+	std::vector<std::size_t> RandomPermutationIndices(std::size_t size, std::size_t count)
+	{
+		std::vector<std::size_t> indices;
+
+		count = std::min(count, size);
+
+		if(count > size / 8)
+		{
+			indices.resize(size);
+
+			for(std::size_t i = 0; i < size; i++)
+			{
+				indices[i] = i;
+			}
+
+			PartialShuffle(indices, count);
+			indices.resize(count);
+			return indices;
+		}
+
+		std::unordered_set<std::size_t> chosen;
+
+		chosen.reserve(count);
+		indices.reserve(count);
+
+		for(std::size_t i = size - count; i < size; i++)
+		{
+			std::size_t index = BoundedSampler<std::size_t>::Next(_engine, 0, i);
+
+			if(!chosen.insert(index).second)
+			{
+				index = i;
+				chosen.insert(index);
+			}
+
+			indices.push_back(index);
+		}
+
+		// Floyd's algorithm yields a random subset, but not in random order
+		Shuffle(indices);
+		return indices;
+	}
+
+	/// <summary>
+	/// Select count random elements of an input range with Algorithm L by K.-H. Li.
+	/// Takes O(count * log(n / count)) random numbers, the elements between the selected ones are skipped.
+	/// The order of the selected elements is unspecified, shuffle them if it matters.
+	/// </summary>
+	/// <param name="range"> - input range, may be read only once</param>
+	/// <param name="count"> - number of elements to select</param>
+	/// <param name="output"> - beginning of a storage for count elements</param>
+	/// <returns>the end of the written elements, fewer than count if the range is shorter</returns>
+	template<std::ranges::input_range TRange, std::random_access_iterator TOutput>
+	TOutput Sample(TRange&& range, std::size_t count, TOutput output) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::Sample);
+
+		auto current = std::ranges::begin(range);
+		const auto last = std::ranges::end(range);
+		std::size_t size = 0;
+
+		for(; size < count && current != last; ++current, size++)
+		{
+			output[size] = *current;
+		}
+
+		if(current == last || count == 0)
+		{
+			return output + size;
+		}
+
+		const BoundedSampler<std::size_t> sampler(0, count - 1);
+		double weight = std::exp(std::log(NextOpenUnit()) / count);
+
+		while(true)
+		{
+			const double skip = std::floor(std::log(NextOpenUnit()) / std::log1p(-weight));
+			const auto distance = skip < static_cast<double>(PTRDIFF_MAX) ? static_cast<std::ptrdiff_t>(skip) : PTRDIFF_MAX;
+
+			std::ranges::advance(current, static_cast<std::ranges::range_difference_t<TRange>>(distance), last);
+
+			if(current == last)
+			{
+				break;
+			}
+
+			output[sampler(_engine)] = *current;
+			++current;
+			weight *= std::exp(std::log(NextOpenUnit()) / count);
+		}
+
+		return output + count;
+	}
+
+	/// <summary>
+	/// Select a random element of a range
+	/// </summary>
+	/// <param name="range"> - sized random access range, not empty</param>
+	/// <returns>a reference to the element</returns>
+	template<std::ranges::random_access_range TRange> requires std::ranges::sized_range<TRange>
+	std::ranges::range_reference_t<TRange> Choice(TRange&& range) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::Choice);
+
+		const std::size_t index = BoundedSampler<std::size_t>::Next(_engine, 0, static_cast<std::size_t>(std::ranges::size(range)) - 1);
+		return std::ranges::begin(range)[static_cast<std::ranges::range_difference_t<TRange>>(index)];
+	}
+
+	/// <summary>
+	/// Copy count random elements of a range to an output, an element may be selected many times.
+	/// The indices are drawn in batches by the vectorized generator, nothing is allocated.
+	/// The elements of a contiguous range larger than SamplePrefetchBytes are prefetched ahead of the copy.
+	/// Takes one seed from the generator.
+	/// </summary>
+	/// <param name="range"> - sized random access range, nothing is written if it is empty</param>
+	/// <param name="count"> - number of elements to copy</param>
+	/// <param name="output"> - output iterator</param>
+	/// <returns>the end of the written elements</returns>
+	template<std::ranges::random_access_range TRange, std::weakly_incrementable TOutput>
+		requires std::ranges::sized_range<TRange> && std::indirectly_copyable<std::ranges::iterator_t<TRange>, TOutput>
+	TOutput SampleWithReplacement(TRange&& range, std::size_t count, TOutput output) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::SampleWithReplacement);
+
+		return SampleWithReplacementSeeded(RandomBits::Next64(_engine), range, count, std::move(output));
+	}
+
+	/// <summary>
+	/// Make a lazy view of count random elements of a sized range, the elements keep their order.
+	/// The view takes one seed from the generator and owns its engine.
+	/// </summary>
+	/// <param name="range"> - sized input range</param>
+	/// <param name="count"> - number of elements to select</param>
+	/// <returns>a view of min(count, size of the range) elements</returns>
+	template<std::ranges::viewable_range TRange> requires std::ranges::input_range<TRange> && std::ranges::sized_range<TRange>
+	RandomSampleView<std::views::all_t<TRange>> SampleView(TRange&& range, std::size_t count) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::SampleView);
+
+		return { std::views::all(std::forward<TRange>(range)), count, RandomBits::Next64(_engine) };
+	}
+
+	/// <summary>
+	/// Make a lazy view of a sized range in a random order, nothing is copied or allocated.
+	/// The view takes one seed from the generator. Use Shuffle when every permutation must be equally likely.
+	/// </summary>
+	/// <param name="range"> - sized forward range, random access makes every element O(1)</param>
+	/// <returns>a view of all elements of the range in a random order</returns>
+	template<std::ranges::viewable_range TRange> requires std::ranges::forward_range<TRange> && std::ranges::sized_range<TRange>
+	RandomShuffledView<std::views::all_t<TRange>> ShuffledView(TRange&& range) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::ShuffledView);
+
+		return { std::views::all(std::forward<TRange>(range)), RandomBits::Next64(_engine) };
+	}
+
+	/// <summary>
+	/// Make a random bijection of [0, size) in O(1) memory, to visit a large space of ids in a random order
+	/// </summary>
+	/// <param name="size"> - number of indices</param>
+	/// <returns>the permutation</returns>
+	FeistelPermutation MakePermutation(std::uint64_t size) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::MakePermutation);
+
+		return FeistelPermutation(size, RandomBits::Next64(_engine));
+	}
+
+	/// <summary>
+	/// Fill a numeric range with random numbers of its element type in a range [min, max] on several threads.
+	/// Real numbers are in a range [min, max). The result depends on the state of the generator only,
+	/// not on the number of threads.
+	/// </summary>
+	/// <param name="range"> - numeric range</param>
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	/// <param name="threadCount"> - maximum number of threads, 0 for all hardware threads</param>
+	template<typename TRange> requires IsArithmeticRange<TRange> && std::ranges::random_access_range<TRange> &&
+									   std::ranges::sized_range<TRange>
+	void ParallelFill(TRange&& range, std::ranges::range_value_t<TRange> min, std::ranges::range_value_t<TRange> max,
+					  unsigned threadCount = 0)
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::ParallelFill);
+
+		ParallelFillChunks(range, RandomBits::Next64(_engine), threadCount, [min, max](const auto& stream, auto chunk)
+		{
+			FillFrom(stream, chunk, min, max);
+		});
+	}
+
+	/// <summary>
+	/// Fill a numeric range with random double numbers in a range [0, 1) on several threads.
+	/// The result depends on the state of the generator only, not on the number of threads.
+	/// </summary>
+	/// <param name="range"> - numeric range</param>
+	/// <param name="threadCount"> - maximum number of threads, 0 for all hardware threads</param>
+	template<typename TRange> requires IsArithmeticRange<TRange> && std::ranges::random_access_range<TRange> &&
+									   std::ranges::sized_range<TRange>
+	void ParallelFill(TRange&& range, unsigned threadCount = 0)
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::ParallelFill);
+
+		ParallelFillChunks(range, RandomBits::Next64(_engine), threadCount, [](const auto& stream, auto chunk)
+		{
+			FillFrom(stream, chunk);
+		});
+	}
+
+	/// <summary>
+	/// Shuffle the range on several threads, each permutation has equal probability of appearance.
+	/// The result depends on the state of the generator only, not on the number of threads.
+	/// </summary>
+	/// <param name="range"> - the range of elements to shuffle randomly</param>
+	/// <param name="threadCount"> - maximum number of threads, 0 for all hardware threads</param>
+	template<typename TRange> requires std::ranges::random_access_range<TRange> && std::ranges::sized_range<TRange>
+	void ParallelShuffle(TRange&& range, unsigned threadCount = 0)
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::ParallelShuffle);
+
+		ParallelShuffleBlocks(range, RandomBits::Next64(_engine), threadCount);
+	}
+};
+
+/// <summary>
+/// Thread-safe BasicRandom, every call is guarded by the mutex of the object
+/// </summary>
+template<typename TEngine>
+class BasicSharedRandom: public BasicRandom<TEngine>
+{
+protected:
+	using Random = BasicRandom<TEngine>;
+
+	std::mutex _mutex;
+
+	std::uint64_t NextSeed() noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		return RandomBits::Next64(this->_engine);
+	}
+public:
+	/// <summary>
+	/// Exclusive access to the generator for a scope: the mutex is held from Lock()
+	/// until the lease is destroyed, and the calls through it do not lock again
+	/// </summary>
+	class Lease
+	{
+		std::mutex* _mutex;
+		Random* _random;
+	public:
+		Lease(std::mutex& mutex, Random& random) noexcept:
+			_mutex(&mutex),
+			_random(&random)
+		{
+			RandomLockGuard::Lock(mutex);
+		}
+
+		Lease(Lease&& other) noexcept:
+			_mutex(std::exchange(other._mutex, nullptr)),
+			_random(other._random)
+		{}
+
+		~Lease()
+		{
+			if(_mutex)
+			{
+				_mutex->unlock();
+			}
+		}
+
+		Lease(const Lease&) = delete;
+		Lease& operator=(const Lease&) = delete;
+		Lease& operator=(Lease&&) = delete;
+
+		Random* operator->() const noexcept
+		{
+			return _random;
+		}
+
+		Random& operator*() const noexcept
+		{
+			return *_random;
+		}
+	};
+
+	BasicSharedRandom() noexcept:
+		Random()
+	{}
+
+	BasicSharedRandom(unsigned int seed) noexcept:
+		Random(seed)
+	{}
+
+	/// <summary>
+	/// Lock the generator for a series of calls, for example
+	/// auto lease = random.Lock(); lease->Next(10); lease->NextDouble();
+	/// Do not call the locking methods of this object while the lease is alive.
+	/// </summary>
+	/// <returns>the lease that unlocks the generator when destroyed</returns>
+	[[nodiscard]] Lease Lock() noexcept
+	{
+		return Lease(_mutex, *this);
+	}
+
+	/// <summary>
+	/// Take a binary image of the engine, a copy of sizeof(TEngine) bytes
+	/// </summary>
+	/// <returns>the state to restore with LoadState</returns>
+	RandomState<TEngine> SaveState() noexcept requires IsSerializableEngine<TEngine>
+	{
+		RandomLockGuard lock(_mutex);
+		return Random::SaveState();
+	}
+
+	/// <summary>
+	/// Restore the engine from a binary image made by SaveState
+	/// </summary>
+	/// <param name="state"> - state of the engine</param>
+	/// <returns>false, and the engine is unchanged, if the image is of another engine</returns>
+	bool LoadState(const RandomState<TEngine>& state) noexcept requires IsSerializableEngine<TEngine>
+	{
+		RandomLockGuard lock(_mutex);
+		return Random::LoadState(state);
+	}
+
+	/// <summary>
+	/// Restore the engine from the bytes of a RandomState, such as a region of a mapped file
+	/// </summary>
+	/// <param name="bytes"> - sizeof(RandomState) bytes, need not be aligned</param>
+	/// <returns>false, and the engine is unchanged, if the bytes are not a state of this engine</returns>
+	bool LoadState(std::span<const std::byte> bytes) noexcept requires IsSerializableEngine<TEngine>
+	{
+		RandomLockGuard lock(_mutex);
+		return Random::LoadState(bytes);
+	}
+
+	/// <summary>
+	/// Derive an independent, not shared child generator in O(1). The mutex is held only to take a seed.
+	/// </summary>
+	/// <returns>a generator to pass to a task by value</returns>
+	Random Split() noexcept requires IsSplittableEngine<TEngine>
+	{
+		return Random::MakeChild(NextSeed());
+	}
+
+	/// <summary>
+	/// Generate a random uint32 number in a range [0, max]
+	/// </summary>
+	/// <param name="max"> - maximum value</param>
+	/// <returns>a random uint32 number in a range [0, max]</returns>
+	unsigned int Next(unsigned int max) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		return Random::Next(max);
+	}
+
+	/// <summary>
+	/// Generate a random int number in a range [min, max]
+	/// </summary>
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	/// <returns>a random number in a range [min, max]</returns>
+	int NextInt(int min, int max) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		return Random::NextInt(min, max);
+	}
+
+	/// <summary>
+	/// Generate a random int64 number in a range [min, max]
+	/// </summary>
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	/// <returns>a random number in a range [min, max]</returns>
+	std::int64_t NextInt64(std::int64_t min, std::int64_t max) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		return Random::NextInt64(min, max);
+	}
+
+	/// <summary>
+	/// Generate a random number in the range of a sampler
+	/// </summary>
+	/// <param name="sampler"> - sampler made by MakeBoundedSampler</param>
+	/// <returns>a random number in a range [sampler.Min(), sampler.Max()]</returns>
+	template<typename TInt>
+	TInt Next(const BoundedSampler<TInt>& sampler) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		return Random::Next(sampler);
+	}
+
+	/// <summary>
+	/// Generate a random index with probability proportional to its weight
+	/// </summary>
+	/// <param name="sampler"> - sampler made by MakeWeightedSampler</param>
+	/// <returns>a random index in a range [0, sampler.Size())</returns>
+	std::size_t Next(const WeightedSampler& sampler) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		return Random::Next(sampler);
+	}
+
+	/// <summary>
+	/// Generate a random real number in a range [min, max)
+	/// </summary>
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	/// <returns>a random real number in a range [min, max)</returns>
+	double NextDouble(double min, double max) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		return Random::NextDouble(min, max);
+	}
+
+	/// <summary>
+	/// Generate a random real number in a range [0, 1)
+	/// </summary>
+	/// <returns>a random real number in a range [0, 1)</returns>
+	double NextDouble() noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		return Random::NextDouble();
+	}
+
+	/// <summary>
+	/// Generate a random float number in a range [min, max)
+	/// </summary>
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	/// <returns>a random float number in a range [min, max)</returns>
+	float NextFloat(float min, float max) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		return Random::NextFloat(min, max);
+	}
+
+	/// <summary>
+	/// Generate a random float number in a range [0, 1)
+	/// </summary>
+	/// <returns>a random float number in a range [0, 1)</returns>
+	float NextFloat() noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		return Random::NextFloat();
+	}
+
+	/// <summary>
+	/// Generate a normally distributed random number with the ziggurat method
+	/// </summary>
+	/// <returns>a random number with mean 0 and deviation 1</returns>
+	double NextNormal() noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		return Random::NextNormal();
+	}
+
+	/// <summary>
+	/// Generate a normally distributed random number with the ziggurat method
+	/// </summary>
+	/// <param name="mean"> - mean</param>
+	/// <param name="deviation"> - standard deviation</param>
+	/// <returns>a random number with the given mean and deviation</returns>
+	double NextNormal(double mean, double deviation) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		return Random::NextNormal(mean, deviation);
+	}
+
+	/// <summary>
+	/// Generate an exponentially distributed random number with the ziggurat method
+	/// </summary>
+	/// <returns>a random number with rate 1</returns>
+	double NextExponential() noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		return Random::NextExponential();
+	}
+
+	/// <summary>
+	/// Generate an exponentially distributed random number with the ziggurat method
+	/// </summary>
+	/// <param name="rate"> - rate, the inverse of the mean</param>
+	/// <returns>a random number with the given rate</returns>
+	double NextExponential(double rate) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		return Random::NextExponential(rate);
+	}
+
+	/// <summary>
+	/// Generate a Poisson distributed random number
+	/// </summary>
+	/// <param name="mean"> - mean, not negative</param>
+	/// <returns>a random number of events</returns>
+	std::uint64_t NextPoisson(double mean) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		return Random::NextPoisson(mean);
+	}
+
+	/// <summary>
+	/// Generate a random number of a distribution
+	/// </summary>
+	/// <param name="distribution"> - distribution such as NormalDistribution</param>
+	/// <returns>a random number</returns>
+	template<typename TDistribution> requires IsDistribution<TDistribution>
+	auto Next(const TDistribution& distribution) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		return Random::Next(distribution);
+	}
+
+	/// <summary>
+	/// Fill a numeric range with random numbers of a distribution
+	/// </summary>
+	/// <param name="range"> - numeric range</param>
+	/// <param name="distribution"> - distribution such as NormalDistribution</param>
+	template<typename TRange, typename TDistribution> requires IsArithmeticRange<TRange> && IsDistribution<TDistribution>
+	void Fill(TRange&& range, const TDistribution& distribution) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		Random::Fill(std::forward<TRange>(range), distribution);
+	}
+
+	/// <summary>
+	/// Fill a numeric range with random numbers of its element type: integers in a range [min, max],
+	/// real numbers in a range [min, max)
+	/// </summary>
+	/// <param name="range"> - numeric range</param>
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	template<typename TRange> requires IsArithmeticRange<TRange>
+	void Fill(TRange&& range, std::ranges::range_value_t<TRange> min, std::ranges::range_value_t<TRange> max) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		Random::Fill(std::forward<TRange>(range), min, max);
+	}
+
+	/// <summary>
+	/// Fill a span with random int numbers in a range [min, max] under one lock
+	/// </summary>
+	/// <param name="values"> - output</param>
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	void NextInts(std::span<int> values, int min, int max) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		Random::NextInts(values, min, max);
+	}
+
+	/// <summary>
+	/// Fill a span with random double numbers in a range [min, max) under one lock
+	/// </summary>
+	/// <param name="values"> - output</param>
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	void NextDoubles(std::span<double> values, double min, double max) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		Random::NextDoubles(values, min, max);
+	}
+
+	/// <summary>
+	/// Fill a numeric range with random double numbers in a range [0, 1)
+	/// </summary>
+	/// <param name="range"> - numeric range</param>
+	template<typename TRange> requires IsArithmeticRange<TRange>
+	void Fill(TRange&& range) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		Random::Fill(std::forward<TRange>(range));
+	}
+
+	/// <summary>
+	/// Fill memory with raw random bits
+	/// </summary>
+	/// <param name="bytes"> - memory to fill</param>
+	void FillBytes(std::span<std::byte> bytes) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		Random::FillBytes(bytes);
+	}
+
+	/// <summary>
+	/// Fill several buffers with raw random bits, like an iovec for writev
+	/// </summary>
+	/// <param name="buffers"> - memory to fill</param>
+	void FillBytes(std::span<const std::span<std::byte>> buffers) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		Random::FillBytes(buffers);
+	}
+
+	/// <summary>
+	/// Fill a buffer with random characters of an alphabet under one lock
+	/// </summary>
+	/// <param name="output"> - buffer to fill</param>
+	/// <param name="alphabet"> - characters to choose from, with equal probabilities</param>
+	/// <returns>false if the alphabet is empty, the buffer is unchanged then</returns>
+	bool FillChars(std::span<char> output, std::string_view alphabet) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		return Random::FillChars(output, alphabet);
+	}
+
+	/// <summary>
+	/// Fill a buffer with random lowercase hexadecimal digits
+	/// </summary>
+	/// <param name="output"> - buffer to fill</param>
+	void FillHex(std::span<char> output) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		Random::FillHex(output);
+	}
+
+	/// <summary>
+	/// Fill a buffer with random characters of the URL-safe base64 alphabet
+	/// </summary>
+	/// <param name="output"> - buffer to fill</param>
+	void FillBase64Url(std::span<char> output) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		Random::FillBase64Url(output);
+	}
+
+	/// <summary>
+	/// Generate a random string of an alphabet
+	/// </summary>
+	/// <param name="length"> - number of characters</param>
+	/// <param name="alphabet"> - characters to choose from, with equal probabilities</param>
+	/// <returns>the string, empty if the alphabet is empty</returns>
+	std::string NextString(std::size_t length, std::string_view alphabet)
+	{
+		std::string result(alphabet.empty() ? 0 : length, '\0');
+
+		FillChars(result, alphabet);
+		return result;
+	}
+
+	/// <summary>
+	/// Write a random version 4 UUID as 36 lowercase characters
+	/// </summary>
+	/// <param name="output"> - buffer of 36 characters</param>
+	void FillUuid(std::span<char, 36> output) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		Random::FillUuid(output);
+	}
+
+	/// <summary>
+	/// Generate a random version 4 UUID without allocation
+	/// </summary>
+	/// <returns>36 lowercase characters, not terminated by zero</returns>
+	std::array<char, 36> NextUuid() noexcept
+	{
+		std::array<char, 36> result;
+
+		FillUuid(result);
+		return result;
+	}
+
+	/// <summary>
+	/// Stream raw random bits to a writer in chunks of WriteChunkSize bytes.
+	/// The mutex is held only to take a seed, not while writing.
+	/// </summary>
+	/// <param name="size"> - number of bytes</param>
+	/// <param name="write"> - called with every chunk, may return false to stop</param>
+	/// <returns>false if the writer stopped or the chunk could not be allocated</returns>
+	template<typename TWrite> requires std::invocable<TWrite&, std::span<const std::byte>>
+	bool WriteBytes(std::uint64_t size, TWrite&& write) noexcept
+	{
+		Xoshiro256PlusPlusX8 generator(NextSeed());
+		return Random::WriteBytesFrom([&generator](std::byte* data, std::size_t count) { generator.FillBytes(data, count); }, size, write);
+	}
+
+	/// <summary>
+	/// Reorders the elements in the given range such
+	/// that each possible permutation of those elements has equal probability of appearance.
+	/// </summary>
+	/// <param name="range"> - 	the range of elements to shuffle randomly</param>
+	template<typename TRange> requires std::ranges::random_access_range<TRange>
+	void Shuffle(TRange&& range) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		Random::Shuffle(std::forward<TRange>(range));
+	}
+
+	/// <summary>
+	/// Shuffle a range larger than the cache through buckets that fit in it.
+	/// The mutex is held only to take a seed, not while shuffling.
+	/// </summary>
+	/// <param name="range"> - the range of elements to shuffle randomly</param>
+	/// <param name="mode"> - the number of threads</param>
+	template<typename TRange> requires std::ranges::random_access_range<TRange> && std::ranges::sized_range<TRange> &&
+									   std::default_initializable<std::ranges::range_value_t<TRange>> &&
+									   std::movable<std::ranges::range_value_t<TRange>>
+	void Shuffle(TRange&& range, CacheAwareShuffle mode) noexcept
+	{
+		Random::CacheAwareShuffleBuckets(range, NextSeed(), mode.ThreadCount);
+	}
+
+	/// <summary>
+	/// Place a random k-permutation of the elements to the beginning of the range with only k swaps.
+	/// The rest of the range holds the other elements in unspecified order.
+	/// </summary>
+	/// <param name="range"> - the range of elements</param>
+	/// <param name="count"> - number of elements to shuffle to the beginning</param>
+	template<typename TRange> requires std::ranges::random_access_range<TRange> && std::ranges::sized_range<TRange>
+	void PartialShuffle(TRange&& range, std::size_t count) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		Random::PartialShuffle(std::forward<TRange>(range), count);
+	}
+
+	/// <summary>
+	/// Generate count distinct random indices in a range [0, size) in random order
+	/// </summary>
+	/// <param name="size"> - number of indices to choose from</param>
+	/// <param name="count"> - number of indices to choose, at most size</param>
+	/// <returns>a random k-permutation of a range [0, size)</returns>
+	std::vector<std::size_t> RandomPermutationIndices(std::size_t size, std::size_t count)
+	{
+		RandomLockGuard lock(_mutex);
+		return Random::RandomPermutationIndices(size, count);
+	}
+
+	/// <summary>
+	/// Select count random elements of an input range with Algorithm L by K.-H. Li.
+	/// The order of the selected elements is unspecified, shuffle them if it matters.
+	/// </summary>
+	/// <param name="range"> - input range, may be read only once</param>
+	/// <param name="count"> - number of elements to select</param>
+	/// <param name="output"> - beginning of a storage for count elements</param>
+	/// <returns>the end of the written elements, fewer than count if the range is shorter</returns>
+	template<std::ranges::input_range TRange, std::random_access_iterator TOutput>
+	TOutput Sample(TRange&& range, std::size_t count, TOutput output) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		return Random::Sample(std::forward<TRange>(range), count, output);
+	}
+
+	/// <summary>
+	/// Select a random element of a range
+	/// </summary>
+	/// <param name="range"> - sized random access range, not empty</param>
+	/// <returns>a reference to the element</returns>
+	template<std::ranges::random_access_range TRange> requires std::ranges::sized_range<TRange>
+	std::ranges::range_reference_t<TRange> Choice(TRange&& range) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		return Random::Choice(std::forward<TRange>(range));
+	}
+
+	/// <summary>
+	/// Copy count random elements of a range to an output, an element may be selected many times.
+	/// The mutex is held only to take a seed, not while copying.
+	/// </summary>
+	/// <param name="range"> - sized random access range, nothing is written if it is empty</param>
+	/// <param name="count"> - number of elements to copy</param>
+	/// <param name="output"> - output iterator</param>
+	/// <returns>the end of the written elements</returns>
+	template<std::ranges::random_access_range TRange, std::weakly_incrementable TOutput>
+		requires std::ranges::sized_range<TRange> && std::indirectly_copyable<std::ranges::iterator_t<TRange>, TOutput>
+	TOutput SampleWithReplacement(TRange&& range, std::size_t count, TOutput output) noexcept
+	{
+		return Random::SampleWithReplacementSeeded(NextSeed(), range, count, std::move(output));
+	}
+
+	/// <summary>
+	/// Make a lazy view of count random elements of a sized range, the elements keep their order.
+	/// The mutex is held only to take a seed, not while iterating.
+	/// </summary>
+	/// <param name="range"> - sized input range</param>
+	/// <param name="count"> - number of elements to select</param>
+	/// <returns>a view of min(count, size of the range) elements</returns>
+	template<std::ranges::viewable_range TRange> requires std::ranges::input_range<TRange> && std::ranges::sized_range<TRange>
+	RandomSampleView<std::views::all_t<TRange>> SampleView(TRange&& range, std::size_t count) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		return Random::SampleView(std::forward<TRange>(range), count);
+	}
+
+	/// <summary>
+	/// Make a lazy view of a sized range in a random order, nothing is copied or allocated.
+	/// The mutex is held only to take a seed, not while iterating.
+	/// </summary>
+	/// <param name="range"> - sized forward range, random access makes every element O(1)</param>
+	/// <returns>a view of all elements of the range in a random order</returns>
+	template<std::ranges::viewable_range TRange> requires std::ranges::forward_range<TRange> && std::ranges::sized_range<TRange>
+	RandomShuffledView<std::views::all_t<TRange>> ShuffledView(TRange&& range) noexcept
+	{
+		RandomLockGuard lock(_mutex);
+		return Random::ShuffledView(std::forward<TRange>(range));
+	}
+
+	/// <summary>
+	/// Make a random bijection of [0, size) in O(1) memory
+	/// </summary>
+	/// <param name="size"> - number of indices</param>
+	/// <returns>the permutation</returns>
+	FeistelPermutation MakePermutation(std::uint64_t size) noexcept
+	{
+		RandomStatistics::CountCall(RandomStatistics::Method::MakePermutation);
+
+		return FeistelPermutation(size, NextSeed());
+	}
+
+	/// <summary>
+	/// Fill a numeric range with random numbers of its element type in a range [min, max] on several threads.
+	/// Real numbers are in a range [min, max). The mutex is held only to take a seed, not while filling.
+	/// </summary>
+	/// <param name="range"> - numeric range</param>
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	/// <param name="threadCount"> - maximum number of threads, 0 for all hardware threads</param>
+	template<typename TRange> requires IsArithmeticRange<TRange> && std::ranges::random_access_range<TRange> &&
+									   std::ranges::sized_range<TRange>
+	void ParallelFill(TRange&& range, std::ranges::range_value_t<TRange> min, std::ranges::range_value_t<TRange> max,
+					  unsigned threadCount = 0)
+	{
+		Random::ParallelFillChunks(range, NextSeed(), threadCount, [min, max](const auto& stream, auto chunk)
+		{
+			Random::FillFrom(stream, chunk, min, max);
+		});
+	}
+
+	/// <summary>
+	/// Fill a numeric range with random double numbers in a range [0, 1) on several threads.
+	/// The mutex is held only to take a seed, not while filling.
+	/// </summary>
+	/// <param name="range"> - numeric range</param>
+	/// <param name="threadCount"> - maximum number of threads, 0 for all hardware threads</param>
+	template<typename TRange> requires IsArithmeticRange<TRange> && std::ranges::random_access_range<TRange> &&
+									   std::ranges::sized_range<TRange>
+	void ParallelFill(TRange&& range, unsigned threadCount = 0)
+	{
+		Random::ParallelFillChunks(range, NextSeed(), threadCount, [](const auto& stream, auto chunk)
+		{
+			Random::FillFrom(stream, chunk);
+		});
+	}
+
+	/// <summary>
+	/// Shuffle the range on several threads, each permutation has equal probability of appearance.
+	/// The mutex is held only to take a seed, not while shuffling.
+	/// </summary>
+	/// <param name="range"> - the range of elements to shuffle randomly</param>
+	/// <param name="threadCount"> - maximum number of threads, 0 for all hardware threads</param>
+	template<typename TRange> requires std::ranges::random_access_range<TRange> && std::ranges::sized_range<TRange>
+	void ParallelShuffle(TRange&& range, unsigned threadCount = 0)
+	{
+		Random::ParallelShuffleBlocks(range, NextSeed(), threadCount);
+	}
+};
+
+using Random = BasicRandom<std::default_random_engine>;
+using SharedRandom = BasicSharedRandom<std::default_random_engine>;
+
+/// <summary>
+/// Random over a Philox4x32 engine: construct it from Philox4x32(seed, stream) moved by Seek
+/// to produce a slice of a global stream
+/// </summary>
+using PhiloxRandom = BasicRandom<Philox4x32>;
+
+/// <summary>
+/// Random that works in constant evaluation, for tables, salts and test data made at compile time.
+/// The same Seed always yields the same numbers, at compile time and at run time alike.
+/// </summary>
+template<std::uint64_t Seed>
+class ConstexprRandom
+{
+protected:
+	Xoshiro256PlusPlus _engine;
+public:
+	using Engine = Xoshiro256PlusPlus;
+
+	constexpr ConstexprRandom() noexcept:
+		_engine(Seed)
+	{}
+
+	/// <summary>
+	/// Generate a random unsigned int number in a range [0, max]
+	/// </summary>
+	/// <param name="max"> - maximum value</param>
+	/// <returns>a random unsigned int number in a range [0, max]</returns>
+	constexpr unsigned int Next(unsigned int max) noexcept
+	{
+		return BoundedSampler<unsigned int>::Next(_engine, 0, max);
+	}
+
+	/// <summary>
+	/// Generate a random int number in a range [min, max]
+	/// </summary>
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	/// <returns>a random number in a range [min, max]</returns>
+	constexpr int NextInt(int min, int max) noexcept
+	{
+		return BoundedSampler<int>::Next(_engine, min, max);
+	}
+
+	/// <summary>
+	/// Generate a random int64 number in a range [min, max]
+	/// </summary>
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	/// <returns>a random number in a range [min, max]</returns>
+	constexpr std::int64_t NextInt64(std::int64_t min, std::int64_t max) noexcept
+	{
+		return BoundedSampler<std::int64_t>::Next(_engine, min, max);
+	}
+
+	/// <summary>
+	/// Generate a random 64-bit number with all bits random, such as a hash salt
+	/// </summary>
+	/// <returns>64 random bits</returns>
+	constexpr std::uint64_t NextBits() noexcept
+	{
+		return _engine();
+	}
+
+	/// <summary>
+	/// Generate a random real number in a range [min, max)
+	/// </summary>
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	/// <returns>a random real number in a range [min, max)</returns>
+	constexpr double NextDouble(double min, double max) noexcept
+	{
+		return std::min(min + (max - min) * NextDouble(), RandomBits::UpperBound(min, max));
+	}
+
+	/// <summary>
+	/// Generate a random double number in a range [0, 1)
+	/// </summary>
+	/// <returns>a random double number in a range [0, 1)</returns>
+	constexpr double NextDouble() noexcept
+	{
+		return RandomBits::ToDouble(_engine());
+	}
+
+	/// <summary>
+	/// Fill a numeric range with random numbers of its element type: integers in a range [min, max],
+	/// real numbers in a range [min, max)
+	/// </summary>
+	/// <param name="range"> - numeric range</param>
+	/// <param name="min"> - minimal value</param>
+	/// <param name="max"> - maximum value</param>
+	template<typename TRange> requires IsArithmeticRange<TRange>
+	constexpr void Fill(TRange&& range, std::ranges::range_value_t<TRange> min, std::ranges::range_value_t<TRange> max) noexcept
+	{
+		PackedFiller::Fill(range, min, max, _engine);
+	}
+
+	/// <summary>
+	/// Reorders the elements in the given range such
+	/// that each possible permutation of those elements has equal probability of appearance.
+	/// Unlike std::ranges::shuffle, the order does not depend on the standard library.
+	/// </summary>
+	/// <param name="range"> - the range of elements to shuffle randomly</param>
+	template<typename TRange> requires std::ranges::random_access_range<TRange> && std::ranges::sized_range<TRange>
+	constexpr void Shuffle(TRange&& range) noexcept
+	{
+		const auto first = std::ranges::begin(range);
+
+		for(std::size_t i = std::ranges::size(range); i > 1; i--)
+		{
+			const std::size_t index = BoundedSampler<std::size_t>::Next(_engine, 0, i - 1);
+			std::ranges::iter_swap(first + (i - 1), first + index);
+		}
+	}
+};
+
+/// <summary>
+/// Engine handle that forwards to a xoshiro256++ engine of the calling thread.
+/// Every thread takes the next long_jump()-separated subsequence of a common xoshiro256++ stream
+/// on its first call. Its engine draws from the first 2^128 outputs of it, and the eight lanes
+/// of its bulk generator from the next eight, therefore the per-thread streams never overlap,
+/// the bulk paths of BasicRandom included.
+/// </summary>
+class ThreadLocalEngine
+{
+protected:
+	struct ThreadState
+	{
+		Xoshiro256PlusPlus Engine;
+		Xoshiro256PlusPlusX8 Bulk;
+		std::uint64_t Generation; // zero-initialized as a thread_local object
+	};
+
+	static inline std::mutex _streamsMutex;
+	static inline Xoshiro256PlusPlus _streams{ SeedSource::Next() };
+	static inline std::atomic<std::uint64_t> _generation = 1;
+	static inline thread_local ThreadState _threadState;
+
+	static void AcquireStream() noexcept
+	{
+		{
+			std::lock_guard<std::mutex> lock(_streamsMutex);
+			_threadState.Engine = _streams;
+			_threadState.Generation = _generation.load(std::memory_order_relaxed);
+			_streams.long_jump();
+		}
+
+		// The lanes are jumped outside of the lock, they take the next eight subsequences
+		Xoshiro256PlusPlus lanes = _threadState.Engine;
+		lanes.jump();
+		_threadState.Bulk = Xoshiro256PlusPlusX8(lanes);
+	}
+public:
+	using result_type = std::uint64_t;
+
+	/// <summary>
+	/// Use the streams seeded from SeedSource at the program start
+	/// </summary>
+	ThreadLocalEngine() noexcept = default;
+
+	/// <summary>
+	/// Reseed the common stream. Threads take new subsequences on their next call
+	/// in the order they make it.
+	/// </summary>
+	/// <param name="value"> - seed value</param>
+	explicit ThreadLocalEngine(std::uint64_t value) noexcept
+	{
+		std::lock_guard<std::mutex> lock(_streamsMutex);
+		_streams.seed(value);
+		_generation.fetch_add(1, std::memory_order_release);
+	}
+
+	static constexpr result_type min() noexcept
+	{
+		return Xoshiro256PlusPlus::min();
+	}
+
+	static constexpr result_type max() noexcept
+	{
+		return Xoshiro256PlusPlus::max();
+	}
+
+	/// <summary>
+	/// The engine of the calling thread
+	/// </summary>
+	static Xoshiro256PlusPlus& Local() noexcept
+	{
+		if(_threadState.Generation != _generation.load(std::memory_order_acquire)) [[unlikely]]
+		{
+			AcquireStream();
+		}
+
+		return _threadState.Engine;
+	}
+
+	/// <summary>
+	/// The bulk generator of the calling thread, whose lanes continue subsequences of that thread only
+	/// </summary>
+	static Xoshiro256PlusPlusX8& BulkGenerator() noexcept
+	{
+		Local();
+		return _threadState.Bulk;
+	}
+
+	result_type operator()() noexcept
+	{
+		return Local()();
+	}
+};
+
+/// <summary>
+/// Random generator that gives each thread its own engine, so no locks are taken on the hot path.
+/// Has the interface of SharedRandom, the per-thread streams never overlap, bulk calls included.
+/// </summary>
+class ThreadLocalRandom: public BasicRandom<ThreadLocalEngine>
+{
+public:
+	/// <summary>
+	/// Use the streams seeded from SeedSource at the program start
+	/// </summary>
+	ThreadLocalRandom() noexcept:
+		BasicRandom(ThreadLocalEngine())
+	{}
+
+	/// <summary>
+	/// Reseed the common stream. Threads take new subsequences on their next call
+	/// in the order they make it.
+	/// </summary>
+	/// <param name="seed"> - seed value</param>
+	ThreadLocalRandom(unsigned int seed) noexcept:
+		BasicRandom(seed)
+	{}
+};
+
+using BufferedRandom = BasicRandom<BufferedEngine<Xoshiro256PlusPlusX8>>;
+
+/// <summary>
+/// Buffered random that can be used from several threads at once
+/// </summary>
+using SharedBufferedRandom = BasicRandom<SharedBufferedEngine<Xoshiro256PlusPlusX8>>;
+
+/// <summary>
+/// SplitMix64 whose state is one atomic counter, so that any number of threads can draw
+/// from one engine at once: a draw is one relaxed fetch_add and never blocks.
+/// The outputs are exactly the SplitMix64 sequence of the same seed, dealt out to the threads
+/// in the order of their fetch_add. SplitMix64 passes BigCrush and PractRand up to at least 32 TB,
+/// has a period of 2^64 and every 64-bit value appears once per period, so no two draws
+/// ever share an output within a period. It is not cryptographically secure,
+/// and the split of the sequence between threads is not reproducible.
+/// The counter still moves between the caches of the cores, so ThreadLocalRandom scales better
+/// when the threads draw at a very high rate.
+/// </summary>
+class AtomicSplitMix64
+{
+protected:
+	std::atomic<std::uint64_t> _state;
+public:
+	using result_type = std::uint64_t;
+
+	explicit AtomicSplitMix64(std::uint64_t value) noexcept:
+		_state(value)
+	{}
+
+	static constexpr result_type min() noexcept
+	{
+		return 0;
+	}
+
+	static constexpr result_type max() noexcept
+	{
+		return UINT64_MAX;
+	}
+
+	void seed(std::uint64_t value) noexcept
+	{
+		_state.store(value, std::memory_order_relaxed);
+	}
+
+	result_type operator()() noexcept
+	{
+		return SplitMix64::Mix(_state.fetch_add(SplitMix64::Gamma, std::memory_order_relaxed) + SplitMix64::Gamma);
+	}
+
+	void discard(unsigned long long count) noexcept
+	{
+		_state.fetch_add(SplitMix64::Gamma * count, std::memory_order_relaxed);
+	}
+};
+
+/// <summary>
+/// Random that can be used from several threads at once without a lock
+/// </summary>
+using LockFreeRandom = BasicRandom<AtomicSplitMix64>;
+
+/// <summary>
+/// NUMA nodes of the machine and the node of every CPU, read once from /sys/devices/system/node on Linux.
+/// Elsewhere, or if the files are missing, the machine is one node of DefaultThreadCount() CPUs.
+/// </summary>
+class NumaTopology
+{
+protected:
+	static constexpr std::size_t MaxCpus = std::size_t(1) << 16;
+
+	static inline std::atomic<std::size_t> _nextThread = 0;
+
+	std::vector<std::uint32_t> _cpuNodes; // node of every CPU
+	std::vector<std::uint32_t> _cpuSlots; // index of every CPU among the CPUs of its node
+	std::vector<std::uint32_t> _nodeSizes; // number of CPUs of every node
+
+#if defined(RANDOM_NUMA_LINUX)
+	/// <summary>
+	/// Call visit(id) for every id of a list such as "0-3,8,10-11" read from a file of sysfs
+	/// </summary>
+	template<typename TVisit>
+	static bool ReadList(const char* path, TVisit&& visit) noexcept
+	{
+		std::FILE* file = std::fopen(path, "r");
+		char text[4096];
+
+		if(file == nullptr)
+		{
+			return false;
+		}
+
+		const bool read = std::fgets(text, sizeof(text), file) != nullptr;
+		const char* current = text;
+
+		std::fclose(file);
+
+		while(read)
+		{
+			char* end = nullptr;
+			const unsigned long first = std::strtoul(current, &end, 10);
+			unsigned long last = first;
+
+			if(end == current)
+			{
+				break;
+			}
+
+			if(*end == '-')
+			{
+				current = end + 1;
+				last = std::strtoul(current, &end, 10);
+			}
+
+			for(unsigned long id = first; id <= last && id < MaxCpus; id++)
+			{
+				visit(static_cast<std::size_t>(id));
+			}
+
+			if(*end != ',')
+			{
+				break;
+			}
+
+			current = end + 1;
+		}
+
+		return read;
+	}
+#endif
+
+	NumaTopology() noexcept
+	{
+		try
+		{
+		#if defined(RANDOM_NUMA_LINUX)
+			std::vector<std::size_t> nodes;
+
+			ReadList("/sys/devices/system/node/online", [&nodes](std::size_t node) { nodes.push_back(node); });
+
+			for(const std::size_t node : nodes)
+			{
+				char path[64];
+
+				std::snprintf(path, sizeof(path), "/sys/devices/system/node/node%zu/cpulist", node);
+				ReadList(path, [this, node](std::size_t cpu)
+				{
+					if(cpu >= _cpuNodes.size())
+					{
+						_cpuNodes.resize(cpu + 1, 0);
+					}
+
+					_cpuNodes[cpu] = static_cast<std::uint32_t>(node);
+				});
+			}
+		#endif
+
+			if(_cpuNodes.empty())
+			{
+				_cpuNodes.assign(ParallelRunner::DefaultThreadCount(), 0);
+			}
+
+			// CPUs missing from the lists, such as offline ones, stay on node 0
+			_cpuSlots.resize(_cpuNodes.size());
+
+			for(std::size_t cpu = 0; cpu < _cpuNodes.size(); cpu++)
+			{
+				const std::uint32_t node = _cpuNodes[cpu];
+
+				if(node >= _nodeSizes.size())
+				{
+					_nodeSizes.resize(node + 1, 0);
+				}
+
+				_cpuSlots[cpu] = _nodeSizes[node]++;
+			}
+		}
+		catch(const std::bad_alloc&)
+		{
+			// No CPU is known then, so the users of the topology fall back to engines of their own threads
+			_cpuNodes.clear();
+			_cpuSlots.clear();
+			_nodeSizes.clear();
+		}
+	}
+public:
+	NumaTopology(const NumaTopology&) = delete;
+	NumaTopology& operator=(const NumaTopology&) = delete;
+
+	/// <summary>
+	/// The topology detected on the first call. It is never destroyed, so threads still running at exit can use it.
+	/// CpuCount() is 0 if the tables of the topology cannot be allocated.
+	/// </summary>
+	static const NumaTopology& Instance() noexcept
+	{
+		alignas(NumaTopology) static std::byte storage[sizeof(NumaTopology)];
+		static const NumaTopology* const topology = ::new(static_cast<void*>(storage)) NumaTopology();
+		return *topology;
+	}
+
+	/// <summary>
+	/// The CPU the calling thread runs on, the thread may move to another one at any time.
+	/// Without sched_getcpu every thread keeps an index given in the order of the first calls.
+	/// </summary>
+	static std::size_t CurrentCpu() noexcept
+	{
+	#if defined(RANDOM_NUMA_LINUX)
+		const int cpu = sched_getcpu();
+
+		if(cpu >= 0)
+		{
+			return static_cast<std::size_t>(cpu);
+		}
+	#endif
+		static thread_local const std::size_t thread = _nextThread.fetch_add(1, std::memory_order_relaxed);
+		return thread;
+	}
+
+	std::size_t CpuCount() const noexcept
+	{
+		return _cpuNodes.size();
+	}
+
+	std::size_t NodeCount() const noexcept
+	{
+		return _nodeSizes.size();
+	}
+
+	/// <param name="cpu"> - CPU less than CpuCount()</param>
+	std::uint32_t NodeOf(std::size_t cpu) const noexcept
+	{
+		return _cpuNodes[cpu];
+	}
+
+	/// <param name="cpu"> - CPU less than CpuCount()</param>
+	/// <returns>index of the CPU among the CPUs of its node</returns>
+	std::uint32_t SlotOf(std::size_t cpu) const noexcept
+	{
+		return _cpuSlots[cpu];
+	}
+
+	/// <param name="node"> - node less than NodeCount()</param>
+	/// <returns>number of CPUs of the node, 0 for a node of memory only</returns>
+	std::uint32_t NodeSize(std::size_t node) const noexcept
+	{
+		return _nodeSizes[node];
+	}
+};
+
+/// <summary>
+/// Process-wide pool of Xoshiro256PlusPlus engines, one per CPU, each alone on its cache line.
+/// The engines of a NUMA node share one block of pages allocated on that node when a thread of the node
+/// makes its first call, so a draw touches only memory of the node it runs on and no line goes across sockets.
+/// A draw never blocks: it claims the engine of its CPU with one atomic exchange on that line, which stays
+/// in the cache of the core. If the engine is busy, because the caller was moved to this CPU in the middle
+/// of another thread's draw, the caller draws from an engine of its own thread instead.
+/// All engines take non-overlapping subsequences of one stream.
+/// </summary>
+class NumaPoolEngine
+{
+protected:
+	/// <summary>
+	/// Engine of one CPU
+	/// </summary>
+	struct alignas(64) Slot
+	{
+		std::atomic_flag Busy;
+		std::uint64_t Generation = 0; // older than any generation, the stream is taken on the first draw
+		Xoshiro256PlusPlus Engine;
+	};
+
+	/// <summary>
+	/// Engine of a thread that finds the engine of its CPU busy
+	/// </summary>
+	struct ThreadState
+	{
+		Xoshiro256PlusPlus Engine;
+		std::uint64_t Generation; // zero-initialized as a thread_local object
+	};
+
+	/// <summary>
+	/// Blocks of slots of every node and the slot of every CPU, allocated on first use. The pool lives
+	/// as long as the process, it is never freed, so detached threads still drawing at exit never touch unmapped memory.
+	/// </summary>
+	class Pool
+	{
+		const NumaTopology& _topology;
+		std::unique_ptr<std::atomic<Slot*>[]> _nodes;
+		std::unique_ptr<std::atomic<Slot*>[]> _cpus; // slot of every CPU, null until the block of its node is allocated
+		std::size_t _cpuCount;
+
+		static std::size_t BlockBytes(std::size_t count) noexcept
+		{
+			constexpr std::size_t page = 4096;
+			return (std::max<std::size_t>(count, 1) * sizeof(Slot) + page - 1) & ~(page - 1);
+		}
+
+		static Slot* Allocate(std::size_t node, std::size_t count) noexcept
+		{
+			const std::size_t size = BlockBytes(count);
+		#if defined(RANDOM_NUMA_LINUX)
+			void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+			if(memory == MAP_FAILED)
+			{
+				return nullptr;
+			}
+
+			#if defined(SYS_mbind)
+			// Prefer the node for the fresh pages. If the kernel refuses, they are placed on the node
+			// of the thread that touches them first, which is this one
+			constexpr int preferred = 1; // MPOL_PREFERRED
+			constexpr std::size_t maskBits = 1024;
+			unsigned long mask[maskBits / (8 * sizeof(unsigned long))] = {};
+
+			if(node < maskBits)
+			{
+				mask[node / (8 * sizeof(unsigned long))] = 1UL << (node % (8 * sizeof(unsigned long)));
+				syscall(SYS_mbind, memory, size, preferred, mask, maskBits + 1, 0);
+			}
+			#endif
+		#else
+			static_cast<void>(node);
+			void* memory = ::operator new(size, std::align_val_t(alignof(Slot)), std::nothrow);
+
+			if(memory == nullptr)
+			{
+				return nullptr;
+			}
+		#endif
+			Slot* slots = static_cast<Slot*>(memory);
+
+			for(std::size_t i = 0; i < std::max<std::size_t>(count, 1); i++)
+			{
+				new(slots + i) Slot();
+			}
+
+			return slots;
+		}
+
+		static void Free(Slot* slots, std::size_t count) noexcept
+		{
+			for(std::size_t i = 0; i < std::max<std::size_t>(count, 1); i++)
+			{
+				slots[i].~Slot();
+			}
+
+		#if defined(RANDOM_NUMA_LINUX)
+			munmap(slots, BlockBytes(count));
+		#else
+			::operator delete(static_cast<void*>(slots), std::align_val_t(alignof(Slot)));
+		#endif
+		}
+
+		/// <summary>
+		/// Find the slot of a CPU, allocating the block of its node on the first call from the node
+		/// </summary>
+		Slot* Attach(std::size_t cpu) noexcept
+		{
+			const std::uint32_t node = _topology.NodeOf(cpu);
+			const std::size_t count = _topology.NodeSize(node);
+			Slot* slots = _nodes[node].load(std::memory_order_acquire);
+
+			if(slots == nullptr)
+			{
+				Slot* allocated = Allocate(node, count);
+
+				if(allocated == nullptr)
+				{
+					return nullptr;
+				}
+
+				if(_nodes[node].compare_exchange_strong(slots, allocated, std::memory_order_acq_rel))
+				{
+					slots = allocated;
+				}
+				else
+				{
+					Free(allocated, count);
+				}
+			}
+
+			Slot* slot = slots + _topology.SlotOf(cpu);
+			_cpus[cpu].store(slot, std::memory_order_release);
+			return slot;
+		}
+	public:
+		explicit Pool(const NumaTopology& topology) noexcept:
+			_topology(topology),
+			_nodes(new(std::nothrow) std::atomic<Slot*>[topology.NodeCount()]()),
+			_cpus(new(std::nothrow) std::atomic<Slot*>[topology.CpuCount()]()),
+			_cpuCount(_nodes && _cpus ? topology.CpuCount() : 0)
+		{}
+
+		/// <summary>
+		/// Slot of a CPU, null if it cannot be allocated
+		/// </summary>
+		RANDOM_ALWAYS_INLINE Slot* CpuSlot(std::size_t cpu) noexcept
+		{
+			if(cpu >= _cpuCount) [[unlikely]]
+			{
+				if(_cpuCount == 0)
+				{
+					return nullptr;
+				}
+
+				cpu %= _cpuCount;
+			}
+
+			Slot* slot = _cpus[cpu].load(std::memory_order_acquire);
+			return slot != nullptr ? slot : Attach(cpu);
+		}
+	};
+
+	static inline std::mutex _streamsMutex;
+	static inline Xoshiro256PlusPlus _streams{ SeedSource::Next() };
+	static inline std::atomic<std::uint64_t> _generation = 1;
+	static inline std::atomic<Pool*> _pool = nullptr;
+	static inline thread_local ThreadState _threadState;
+
+	/// <summary>
+	/// Make the pool on the first draw of the process
+	/// </summary>
+	static Pool* CreatePool() noexcept
+	{
+		Pool* created = new(std::nothrow) Pool(NumaTopology::Instance());
+		Pool* pool = nullptr;
+
+		if(created != nullptr && !_pool.compare_exchange_strong(pool, created, std::memory_order_acq_rel))
+		{
+			delete created;
+			return pool;
+		}
+
+		return created;
+	}
+
+	static void AcquireStream(Xoshiro256PlusPlus& engine, std::uint64_t& generation) noexcept
+	{
+		std::lock_guard<std::mutex> lock(_streamsMutex);
+		engine = _streams;
+		generation = _generation.load(std::memory_order_relaxed);
+		_streams.jump();
+	}
+
+	/// <summary>
+	/// Draw from the engine of the calling thread
+	/// </summary>
+	static std::uint64_t NextLocal() noexcept
+	{
+		if(_threadState.Generation != _generation.load(std::memory_order_acquire))
+		{
+			AcquireStream(_threadState.Engine, _threadState.Generation);
+		}
+
+		return _threadState.Engine();
+	}
+public:
+	using result_type = std::uint64_t;
+
+	/// <summary>
+	/// Use the streams seeded from SeedSource at the program start
+	/// </summary>
+	NumaPoolEngine() noexcept = default;
+
+	/// <summary>
+	/// Reseed the common stream. The engines of the CPUs take new subsequences on their next draw
+	/// in the order they make it.
+	/// </summary>
+	/// <param name="value"> - seed value</param>
+	explicit NumaPoolEngine(std::uint64_t value) noexcept
+	{
+		std::lock_guard<std::mutex> lock(_streamsMutex);
+		_streams.seed(value);
+		_generation.fetch_add(1, std::memory_order_release);
+	}
+
+	static constexpr result_type min() noexcept
+	{
+		return Xoshiro256PlusPlus::min();
+	}
+
+	static constexpr result_type max() noexcept
+	{
+		return Xoshiro256PlusPlus::max();
+	}
+
+	result_type operator()() noexcept
+	{
+		Pool* pool = _pool.load(std::memory_order_acquire);
+
+		if(pool == nullptr) [[unlikely]]
+		{
+			pool = CreatePool();
+		}
+
+		Slot* slot = pool != nullptr ? pool->CpuSlot(NumaTopology::CurrentCpu()) : nullptr;
+
+		if(slot == nullptr || slot->Busy.test_and_set(std::memory_order_acquire)) [[unlikely]]
+		{
+			return NextLocal();
+		}
+
+		if(slot->Generation != _generation.load(std::memory_order_acquire)) [[unlikely]]
+		{
+			AcquireStream(slot->Engine, slot->Generation);
+		}
+
+		const result_type value = slot->Engine();
+
+		slot->Busy.clear(std::memory_order_release);
+		return value;
+	}
+};
+
+/// <summary>
+/// Random generator that draws from the engine of the CPU it runs on, allocated on the NUMA node of that CPU,
+/// so that threads on different sockets never share a cache line. Has the interface of SharedRandom.
+/// Prefer ThreadLocalRandom when threads are few and long-lived, it needs no atomic operation at all.
+/// </summary>
+class NumaRandom: public BasicRandom<NumaPoolEngine>
+{
+public:
+	/// <summary>
+	/// Use the streams seeded from SeedSource at the program start
+	/// </summary>
+	NumaRandom() noexcept:
+		BasicRandom(NumaPoolEngine())
+	{}
+
+	/// <summary>
+	/// Reseed the common stream. The engines of the CPUs take new subsequences on their next draw
+	/// in the order they make it.
+	/// </summary>
+	/// <param name="seed"> - seed value</param>
+	NumaRandom(unsigned int seed) noexcept:
+		BasicRandom(seed)
+	{}
 };
\ No newline at end of file
@@ -0,0 +1,471 @@
+#include <Random.h>
+
+#include <benchmark/benchmark.h>
+
+#include <numeric>
+#include <thread>
+#include <vector>
+
+using XoshiroRandom = BasicRandom<Xoshiro256PlusPlus>;
+using PcgRandom = BasicRandom<Pcg64>;
+
+static const int MaxThreads = static_cast<int>(ParallelRunner::DefaultThreadCount());
+
+/// <summary>
+/// Register a benchmark template for every engine
+/// </summary>
+#define RANDOM_BENCHMARK_ENGINES(function) \
+	BENCHMARK_TEMPLATE(function, Random); \
+	BENCHMARK_TEMPLATE(function, XoshiroRandom); \
+	BENCHMARK_TEMPLATE(function, PcgRandom); \
+	BENCHMARK_TEMPLATE(function, ThreadLocalRandom); \
+	BENCHMARK_TEMPLATE(function, BufferedRandom); \
+	BENCHMARK_TEMPLATE(function, SharedRandom); \
+	BENCHMARK_TEMPLATE(function, SharedBufferedRandom)
+
+/// <summary>
+/// Register a range benchmark template for every engine and several range sizes
+/// </summary>
+#define RANDOM_BENCHMARK_RANGES(function) \
+	BENCHMARK_TEMPLATE(function, Random)->RangeMultiplier(16)->Range(64, 1 << 22); \
+	BENCHMARK_TEMPLATE(function, XoshiroRandom)->RangeMultiplier(16)->Range(64, 1 << 22); \
+	BENCHMARK_TEMPLATE(function, PcgRandom)->RangeMultiplier(16)->Range(64, 1 << 22); \
+	BENCHMARK_TEMPLATE(function, SharedRandom)->RangeMultiplier(16)->Range(64, 1 << 22)
+
+template<typename TValue>
+static void SetRangeCounters(benchmark::State& state) noexcept
+{
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(TValue));
+}
+
+template<typename TRandom>
+static void Next(benchmark::State& state)
+{
+	TRandom random(1);
+
+	for(auto _ : state)
+	{
+		benchmark::DoNotOptimize(random.Next(1000));
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+template<typename TRandom>
+static void NextInt(benchmark::State& state)
+{
+	TRandom random(1);
+
+	for(auto _ : state)
+	{
+		benchmark::DoNotOptimize(random.NextInt(-1000, 1000));
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+template<typename TRandom>
+static void NextDouble(benchmark::State& state)
+{
+	TRandom random(1);
+
+	for(auto _ : state)
+	{
+		benchmark::DoNotOptimize(random.NextDouble());
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+template<typename TRandom>
+static void NextDoubleRange(benchmark::State& state)
+{
+	TRandom random(1);
+
+	for(auto _ : state)
+	{
+		benchmark::DoNotOptimize(random.NextDouble(-1.0, 1.0));
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+template<typename TRandom>
+static void NextWeighted(benchmark::State& state)
+{
+	TRandom random(1);
+	std::vector<double> weights(state.range(0));
+
+	std::iota(weights.begin(), weights.end(), 1.0);
+
+	const WeightedSampler sampler = TRandom::MakeWeightedSampler(weights);
+
+	for(auto _ : state)
+	{
+		benchmark::DoNotOptimize(random.Next(sampler));
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+template<typename TRandom>
+static void NextNormal(benchmark::State& state)
+{
+	TRandom random(1);
+
+	for(auto _ : state)
+	{
+		benchmark::DoNotOptimize(random.NextNormal());
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+template<typename TRandom>
+static void NextExponential(benchmark::State& state)
+{
+	TRandom random(1);
+
+	for(auto _ : state)
+	{
+		benchmark::DoNotOptimize(random.NextExponential());
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+template<typename TRandom>
+static void NextPoisson(benchmark::State& state)
+{
+	TRandom random(1);
+	const PoissonDistribution distribution(static_cast<double>(state.range(0)));
+
+	for(auto _ : state)
+	{
+		benchmark::DoNotOptimize(random.Next(distribution));
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+template<typename TRandom>
+static void FillInt(benchmark::State& state)
+{
+	TRandom random(1);
+	std::vector<int> values(state.range(0));
+
+	for(auto _ : state)
+	{
+		random.Fill(values, -1000, 1000);
+		benchmark::DoNotOptimize(values.data());
+		benchmark::ClobberMemory();
+	}
+
+	SetRangeCounters<int>(state);
+}
+
+template<typename TRandom>
+static void FillByte(benchmark::State& state)
+{
+	TRandom random(1);
+	std::vector<std::uint8_t> values(state.range(0));
+
+	for(auto _ : state)
+	{
+		random.Fill(values, 0, 99);
+		benchmark::DoNotOptimize(values.data());
+		benchmark::ClobberMemory();
+	}
+
+	SetRangeCounters<std::uint8_t>(state);
+}
+
+template<typename TRandom>
+static void FillDouble(benchmark::State& state)
+{
+	TRandom random(1);
+	std::vector<double> values(state.range(0));
+
+	for(auto _ : state)
+	{
+		random.Fill(values, -1.0, 1.0);
+		benchmark::DoNotOptimize(values.data());
+		benchmark::ClobberMemory();
+	}
+
+	SetRangeCounters<double>(state);
+}
+
+template<typename TRandom>
+static void FillUnit(benchmark::State& state)
+{
+	TRandom random(1);
+	std::vector<double> values(state.range(0));
+
+	for(auto _ : state)
+	{
+		random.Fill(values);
+		benchmark::DoNotOptimize(values.data());
+		benchmark::ClobberMemory();
+	}
+
+	SetRangeCounters<double>(state);
+}
+
+template<typename TRandom>
+static void FillNormal(benchmark::State& state)
+{
+	TRandom random(1);
+	std::vector<double> values(state.range(0));
+
+	for(auto _ : state)
+	{
+		random.Fill(values, NormalDistribution(0.0, 1.0));
+		benchmark::DoNotOptimize(values.data());
+		benchmark::ClobberMemory();
+	}
+
+	SetRangeCounters<double>(state);
+}
+
+template<typename TRandom>
+static void FillBytes(benchmark::State& state)
+{
+	TRandom random(1);
+	std::vector<std::byte> bytes(state.range(0));
+
+	for(auto _ : state)
+	{
+		random.FillBytes(bytes);
+		benchmark::DoNotOptimize(bytes.data());
+		benchmark::ClobberMemory();
+	}
+
+	SetRangeCounters<std::byte>(state);
+}
+
+template<typename TRandom>
+static void FillChars(benchmark::State& state)
+{
+	TRandom random(1);
+	std::vector<char> chars(state.range(0));
+
+	for(auto _ : state)
+	{
+		random.FillChars(chars, "0123456789");
+		benchmark::DoNotOptimize(chars.data());
+		benchmark::ClobberMemory();
+	}
+
+	SetRangeCounters<char>(state);
+}
+
+template<typename TRandom>
+static void FillHex(benchmark::State& state)
+{
+	TRandom random(1);
+	std::vector<char> chars(state.range(0));
+
+	for(auto _ : state)
+	{
+		random.FillHex(chars);
+		benchmark::DoNotOptimize(chars.data());
+		benchmark::ClobberMemory();
+	}
+
+	SetRangeCounters<char>(state);
+}
+
+template<typename TRandom>
+static void NextUuid(benchmark::State& state)
+{
+	TRandom random(1);
+
+	for(auto _ : state)
+	{
+		benchmark::DoNotOptimize(random.NextUuid());
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+template<typename TRandom>
+static void SampleWithReplacement(benchmark::State& state)
+{
+	TRandom random(1);
+	std::vector<double> values(state.range(0));
+	std::vector<double> samples(state.range(0));
+
+	std::iota(values.begin(), values.end(), 0.0);
+
+	for(auto _ : state)
+	{
+		random.SampleWithReplacement(values, samples.size(), samples.begin());
+		benchmark::DoNotOptimize(samples.data());
+		benchmark::ClobberMemory();
+	}
+
+	SetRangeCounters<double>(state);
+}
+
+template<typename TRandom>
+static void Shuffle(benchmark::State& state)
+{
+	TRandom random(1);
+	std::vector<int> values(state.range(0));
+
+	std::iota(values.begin(), values.end(), 0);
+
+	for(auto _ : state)
+	{
+		random.Shuffle(values);
+		benchmark::DoNotOptimize(values.data());
+		benchmark::ClobberMemory();
+	}
+
+	SetRangeCounters<int>(state);
+}
+
+template<typename TRandom>
+static void CacheAwareShuffleInt(benchmark::State& state)
+{
+	TRandom random(1);
+	std::vector<int> values(state.range(0));
+
+	std::iota(values.begin(), values.end(), 0);
+
+	for(auto _ : state)
+	{
+		random.Shuffle(values, CacheAwareShuffle{ static_cast<unsigned>(state.range(1)) });
+		benchmark::DoNotOptimize(values.data());
+		benchmark::ClobberMemory();
+	}
+
+	SetRangeCounters<int>(state);
+}
+
+template<typename TRandom>
+static void ParallelFillDouble(benchmark::State& state)
+{
+	TRandom random(1);
+	std::vector<double> values(state.range(0));
+
+	for(auto _ : state)
+	{
+		random.ParallelFill(values, -1.0, 1.0);
+		benchmark::DoNotOptimize(values.data());
+		benchmark::ClobberMemory();
+	}
+
+	SetRangeCounters<double>(state);
+}
+
+template<typename TRandom>
+static void ParallelShuffle(benchmark::State& state)
+{
+	TRandom random(1);
+	std::vector<int> values(state.range(0));
+
+	std::iota(values.begin(), values.end(), 0);
+
+	for(auto _ : state)
+	{
+		random.ParallelShuffle(values);
+		benchmark::DoNotOptimize(values.data());
+		benchmark::ClobberMemory();
+	}
+
+	SetRangeCounters<int>(state);
+}
+
+/// <summary>
+/// All benchmark threads draw from one object, so the numbers show the cost of contention
+/// </summary>
+template<typename TRandom>
+static void ContendedNextInt(benchmark::State& state)
+{
+	static TRandom random(1);
+
+	for(auto _ : state)
+	{
+		benchmark::DoNotOptimize(random.NextInt(-1000, 1000));
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+/// <summary>
+/// Draws 50 numbers per lock
+/// </summary>
+template<typename TRandom>
+static void ContendedLeaseNextInt(benchmark::State& state)
+{
+	static TRandom random(1);
+
+	for(auto _ : state)
+	{
+		auto lease = random.Lock();
+
+		for(int i = 0; i < 50; i++)
+		{
+			benchmark::DoNotOptimize(lease->NextInt(-1000, 1000));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * 50);
+}
+
+template<typename TRandom>
+static void ContendedFillInt(benchmark::State& state)
+{
+	static TRandom random(1);
+	std::vector<int> values(state.range(0));
+
+	for(auto _ : state)
+	{
+		random.Fill(values, -1000, 1000);
+		benchmark::DoNotOptimize(values.data());
+		benchmark::ClobberMemory();
+	}
+
+	SetRangeCounters<int>(state);
+}
+
+RANDOM_BENCHMARK_ENGINES(Next);
+RANDOM_BENCHMARK_ENGINES(NextInt);
+RANDOM_BENCHMARK_ENGINES(NextDouble);
+RANDOM_BENCHMARK_ENGINES(NextDoubleRange);
+
+BENCHMARK_TEMPLATE(NextWeighted, XoshiroRandom)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK_TEMPLATE(NextWeighted, SharedRandom)->Arg(1 << 10);
+
+RANDOM_BENCHMARK_ENGINES(NextNormal);
+RANDOM_BENCHMARK_ENGINES(NextExponential);
+BENCHMARK_TEMPLATE(NextPoisson, XoshiroRandom)->Arg(4)->Arg(100);
+
+RANDOM_BENCHMARK_RANGES(FillInt);
+RANDOM_BENCHMARK_RANGES(FillByte);
+RANDOM_BENCHMARK_RANGES(FillDouble);
+RANDOM_BENCHMARK_RANGES(FillUnit);
+RANDOM_BENCHMARK_RANGES(FillNormal);
+RANDOM_BENCHMARK_RANGES(FillBytes);
+RANDOM_BENCHMARK_RANGES(FillChars);
+RANDOM_BENCHMARK_RANGES(FillHex);
+RANDOM_BENCHMARK_ENGINES(NextUuid);
+RANDOM_BENCHMARK_RANGES(SampleWithReplacement);
+RANDOM_BENCHMARK_RANGES(Shuffle);
+
+BENCHMARK_TEMPLATE(ParallelFillDouble, XoshiroRandom)->RangeMultiplier(16)->Range(1 << 18, 1 << 24)->UseRealTime();
+BENCHMARK_TEMPLATE(CacheAwareShuffleInt, XoshiroRandom)->ArgsProduct({ { 1 << 18, 1 << 22, 1 << 26 }, { 1, 0 } })->UseRealTime();
+BENCHMARK_TEMPLATE(ParallelShuffle, XoshiroRandom)->RangeMultiplier(16)->Range(1 << 18, 1 << 24)->UseRealTime();
+
+BENCHMARK_TEMPLATE(ContendedNextInt, SharedRandom)->ThreadRange(1, MaxThreads)->UseRealTime();
+BENCHMARK_TEMPLATE(ContendedNextInt, SharedBufferedRandom)->ThreadRange(1, MaxThreads)->UseRealTime();
+BENCHMARK_TEMPLATE(ContendedNextInt, ThreadLocalRandom)->ThreadRange(1, MaxThreads)->UseRealTime();
+BENCHMARK_TEMPLATE(ContendedNextInt, LockFreeRandom)->ThreadRange(1, MaxThreads)->UseRealTime();
+BENCHMARK_TEMPLATE(ContendedNextInt, NumaRandom)->ThreadRange(1, MaxThreads)->UseRealTime();
+BENCHMARK_TEMPLATE(ContendedLeaseNextInt, SharedRandom)->ThreadRange(1, MaxThreads)->UseRealTime();
+BENCHMARK_TEMPLATE(ContendedFillInt, SharedRandom)->Arg(1 << 12)->ThreadRange(1, MaxThreads)->UseRealTime();
+
+BENCHMARK_MAIN();
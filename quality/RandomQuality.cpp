@@ -0,0 +1,515 @@
+#include <Random.h>
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+	#include <fcntl.h>
+	#include <io.h>
+#endif
+
+#if defined(RANDOM_QUALITY_TESTU01)
+extern "C"
+{
+	#include <TestU01.h>
+}
+#endif
+
+/// <summary>
+/// Streams raw output of the engines and bulk kernels of Random.h to stdout for PractRand and TestU01
+/// and measures the bytes per second every source reaches:
+///
+///     random_quality xoshiro | RNG_test stdin64
+///     random_quality x8 1T --report quality.csv | RNG_test stdin64 -tlmax 1T
+///     random_quality --throughput 1G --report quality.csv
+///     random_quality --testu01 bigcrush split
+///
+/// Every source writes 64-bit words in the native byte order, read them with stdin64.
+/// </summary>
+
+/// <summary>
+/// Fills a chunk of a multiple of 8 bytes with the next bytes of a stream
+/// </summary>
+using ChunkWriter = std::function<void(std::span<std::byte>)>;
+
+struct Source
+{
+	const char* Name;
+	const char* Description;
+	ChunkWriter (*Make)(std::uint64_t seed);
+};
+
+/// <summary>
+/// Bytes generated between two writes to stdout
+/// </summary>
+static constexpr std::size_t ChunkSize = std::size_t(1) << 20;
+
+/// <summary>
+/// Number of children interleaved by the split source
+/// </summary>
+static constexpr std::size_t SplitChildren = 8;
+
+/// <summary>
+/// Number of ParallelChunkSize blocks in one call of the parallel source, so that the blocks go to several threads
+/// </summary>
+static constexpr std::size_t ParallelBlocks = 8;
+
+static volatile std::sig_atomic_t _stopped = 0;
+static volatile std::byte _sink;
+
+/// <summary>
+/// Raw 64-bit outputs of an engine as the scalar methods of BasicRandom draw them
+/// </summary>
+template<typename TEngine>
+static ChunkWriter MakeScalar(std::uint64_t seed)
+{
+	auto engine = std::make_shared<TEngine>(static_cast<typename TEngine::result_type>(seed));
+
+	return [engine](std::span<std::byte> chunk)
+	{
+		for(std::size_t i = 0; i < chunk.size(); i += sizeof(std::uint64_t))
+		{
+			const std::uint64_t bits = RandomBits::Next64(*engine);
+			std::memcpy(chunk.data() + i, &bits, sizeof(bits));
+		}
+	};
+}
+
+/// <summary>
+/// Xoshiro256PlusPlusX8 filling one stream of bytes, as WriteBytes does
+/// </summary>
+static ChunkWriter MakeX8(std::uint64_t seed)
+{
+	auto generator = std::make_shared<Xoshiro256PlusPlusX8>(seed);
+
+	return [generator](std::span<std::byte> chunk)
+	{
+		generator->FillBytes(chunk.data(), chunk.size());
+	};
+}
+
+/// <summary>
+/// BasicRandom::FillBytes, every chunk is filled by a fresh Xoshiro256PlusPlusX8 seeded from the engine
+/// </summary>
+static ChunkWriter MakeFillBytes(std::uint64_t seed)
+{
+	auto random = std::make_shared<BasicRandom<Xoshiro256PlusPlus>>(Xoshiro256PlusPlus(seed));
+
+	return [random](std::span<std::byte> chunk)
+	{
+		random->FillBytes(chunk);
+	};
+}
+
+/// <summary>
+/// BasicRandom::Fill of full-range 32-bit integers, the vectorized bounded kernel
+/// </summary>
+static ChunkWriter MakeFillInts(std::uint64_t seed)
+{
+	auto random = std::make_shared<BasicRandom<Xoshiro256PlusPlus>>(Xoshiro256PlusPlus(seed));
+
+	auto words = std::make_shared<std::vector<std::uint32_t>>(ChunkSize / sizeof(std::uint32_t));
+
+	return [random, words](std::span<std::byte> chunk)
+	{
+		const std::span<std::uint32_t> part(words->data(), chunk.size() / sizeof(std::uint32_t));
+
+		random->Fill(part, 0, std::numeric_limits<std::uint32_t>::max());
+		std::memcpy(chunk.data(), part.data(), part.size_bytes());
+	};
+}
+
+/// <summary>
+/// BasicRandom::ParallelFill with all hardware threads over ParallelBlocks blocks of ParallelChunkSize words,
+/// so the blocks of independent streams follow one another in the output
+/// </summary>
+static ChunkWriter MakeParallel(std::uint64_t seed)
+{
+	using TRandom = BasicRandom<Xoshiro256PlusPlus>;
+
+	struct State
+	{
+		TRandom Random;
+		std::vector<std::uint64_t> Words;
+		std::size_t Position;
+	};
+
+	auto state = std::make_shared<State>(State{ TRandom(Xoshiro256PlusPlus(seed)), std::vector<std::uint64_t>(ParallelBlocks * TRandom::ParallelChunkSize), ParallelBlocks * TRandom::ParallelChunkSize });
+
+	return [state](std::span<std::byte> chunk)
+	{
+		for(std::size_t written = 0; written < chunk.size();)
+		{
+			if(state->Position == state->Words.size())
+			{
+				state->Random.ParallelFill(state->Words, 0, std::numeric_limits<std::uint64_t>::max());
+				state->Position = 0;
+			}
+
+			const std::size_t count = std::min(chunk.size() - written, (state->Words.size() - state->Position) * sizeof(std::uint64_t));
+
+			std::memcpy(chunk.data() + written, state->Words.data() + state->Position, count);
+			state->Position += count / sizeof(std::uint64_t);
+			written += count;
+		}
+	};
+}
+
+/// <summary>
+/// Words of SplitChildren generators made by Split(), interleaved, so correlations between children show up
+/// </summary>
+static ChunkWriter MakeSplit(std::uint64_t seed)
+{
+	using TRandom = BasicRandom<Xoshiro256PlusPlus>;
+
+	TRandom parent{ Xoshiro256PlusPlus(seed) };
+	auto children = std::make_shared<std::vector<TRandom>>();
+
+	for(std::size_t i = 0; i < SplitChildren; i++)
+	{
+		children->push_back(parent.Split());
+	}
+
+	return [children](std::span<std::byte> chunk)
+	{
+		for(std::size_t i = 0, child = 0; i < chunk.size(); i += sizeof(std::uint64_t), child = (child + 1) % SplitChildren)
+		{
+			const auto bits = static_cast<std::uint64_t>((*children)[child].NextInt64(std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max()));
+			std::memcpy(chunk.data() + i, &bits, sizeof(bits));
+		}
+	};
+}
+
+/// <summary>
+/// Philox4x32::Fill, the counter-based path that PhiloxKernel reproduces on devices
+/// </summary>
+static ChunkWriter MakePhilox(std::uint64_t seed)
+{
+	auto offset = std::make_shared<std::uint64_t>(0);
+	const Philox4x32 engine(seed, 0);
+
+	return [engine, offset](std::span<std::byte> chunk)
+	{
+		const std::span<std::uint64_t> words(reinterpret_cast<std::uint64_t*>(chunk.data()), chunk.size() / sizeof(std::uint64_t));
+
+		engine.Fill(words, *offset);
+		*offset += words.size();
+	};
+}
+
+static const Source Sources[] =
+{
+	{ "default", "std::default_random_engine, the engine of Random and SharedRandom", MakeScalar<std::default_random_engine> },
+	{ "splitmix", "SplitMix64", MakeScalar<SplitMix64> },
+	{ "xoshiro", "Xoshiro256PlusPlus", MakeScalar<Xoshiro256PlusPlus> },
+	{ "pcg", "Pcg64", MakeScalar<Pcg64> },
+	{ "philox", "Philox4x32::Fill", MakePhilox },
+	{ "lockfree", "AtomicSplitMix64, the engine of LockFreeRandom", MakeScalar<AtomicSplitMix64> },
+	{ "threadlocal", "ThreadLocalEngine, the engine of ThreadLocalRandom", MakeScalar<ThreadLocalEngine> },
+	{ "numa", "NumaPoolEngine, the engine of NumaRandom", MakeScalar<NumaPoolEngine> },
+	{ "buffered", "BufferedEngine<Xoshiro256PlusPlusX8>, the engine of BufferedRandom", MakeScalar<BufferedEngine<Xoshiro256PlusPlusX8>> },
+	{ "sharedbuffered", "SharedBufferedEngine<Xoshiro256PlusPlusX8>, the engine of SharedBufferedRandom", MakeScalar<SharedBufferedEngine<Xoshiro256PlusPlusX8>> },
+	{ "x8", "Xoshiro256PlusPlusX8::FillBytes, the stream of WriteBytes", MakeX8 },
+	{ "fillbytes", "BasicRandom::FillBytes, reseeded every chunk", MakeFillBytes },
+	{ "fillints", "BasicRandom::Fill of 32-bit integers", MakeFillInts },
+	{ "parallel", "BasicRandom::ParallelFill", MakeParallel },
+	{ "split", "BasicRandom::Split, children interleaved", MakeSplit }
+};
+
+static const Source* FindSource(std::string_view name) noexcept
+{
+	for(const Source& source : Sources)
+	{
+		if(name == source.Name)
+		{
+			return &source;
+		}
+	}
+
+	return nullptr;
+}
+
+/// <summary>
+/// Parse a number of bytes with an optional K, M, G or T suffix of binary units
+/// </summary>
+/// <returns>false if the text is not a number</returns>
+static bool ParseBytes(const char* text, std::uint64_t& bytes) noexcept
+{
+	char* end = nullptr;
+	const unsigned long long value = std::strtoull(text, &end, 10);
+	int shift = 0;
+
+	if(end == text)
+	{
+		return false;
+	}
+
+	switch(*end)
+	{
+		case 'K': case 'k': shift = 10; end++; break;
+		case 'M': case 'm': shift = 20; end++; break;
+		case 'G': case 'g': shift = 30; end++; break;
+		case 'T': case 't': shift = 40; end++; break;
+		default: break;
+	}
+
+	bytes = static_cast<std::uint64_t>(value) << shift;
+	return *end == '\0';
+}
+
+/// <summary>
+/// Append a line "source,bytes,seconds,bytes_per_second" to a report, the header is written to a new file
+/// </summary>
+static void Report(const char* path, const Source& source, std::uint64_t bytes, double seconds) noexcept
+{
+	const double rate = seconds > 0 ? static_cast<double>(bytes) / seconds : 0;
+
+	std::fprintf(stderr, "%-14s %14llu bytes %10.3f s %10.1f MB/s\n", source.Name, static_cast<unsigned long long>(bytes), seconds, rate / 1e6);
+
+	if(path == nullptr)
+	{
+		return;
+	}
+
+	std::FILE* file = std::fopen(path, "a");
+
+	if(file == nullptr)
+	{
+		std::fprintf(stderr, "cannot open %s\n", path);
+		return;
+	}
+
+	if(std::ftell(file) == 0)
+	{
+		std::fprintf(file, "source,bytes,seconds,bytes_per_second\n");
+	}
+
+	std::fprintf(file, "%s,%llu,%.6f,%.0f\n", source.Name, static_cast<unsigned long long>(bytes), seconds, rate);
+	std::fclose(file);
+}
+
+/// <summary>
+/// Generate size bytes of a source, 0 for an endless stream, and pass every chunk to output
+/// </summary>
+/// <returns>number of bytes accepted by output, it returns false to stop</returns>
+template<typename TOutput>
+static std::uint64_t Run(const Source& source, std::uint64_t seed, std::uint64_t size, TOutput&& output)
+{
+	std::vector<std::uint64_t> buffer(ChunkSize / sizeof(std::uint64_t));
+	const std::span<std::byte> chunk(reinterpret_cast<std::byte*>(buffer.data()), ChunkSize);
+	const ChunkWriter write = source.Make(seed);
+	std::uint64_t total = 0;
+
+	while(!_stopped && (size == 0 || total < size))
+	{
+		const std::size_t count = size == 0 ? ChunkSize : static_cast<std::size_t>(std::min<std::uint64_t>(size - total, ChunkSize));
+		// Sources write whole words, a last partial word is generated and cut
+		const std::span<std::byte> part = chunk.first((count + sizeof(std::uint64_t) - 1) & ~(sizeof(std::uint64_t) - 1));
+
+		write(part);
+
+		if(!output(part.first(count)))
+		{
+			break;
+		}
+
+		total += count;
+	}
+
+	return total;
+}
+
+static double SecondsSince(std::chrono::steady_clock::time_point start) noexcept
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+#if defined(RANDOM_QUALITY_TESTU01)
+static ChunkWriter _testWrite;
+static std::vector<std::uint32_t> _testWords(ChunkSize / sizeof(std::uint32_t));
+static std::size_t _testPosition = ChunkSize / sizeof(std::uint32_t);
+
+/// <summary>
+/// 32-bit words of the stream one after another, both halves of every 64-bit word are tested
+/// </summary>
+static unsigned int NextTestWord()
+{
+	if(_testPosition == _testWords.size())
+	{
+		_testWrite(std::as_writable_bytes(std::span(_testWords)));
+		_testPosition = 0;
+	}
+
+	return _testWords[_testPosition++];
+}
+
+/// <summary>
+/// Run a TestU01 battery over a source in process
+/// </summary>
+/// <returns>false if the battery is unknown</returns>
+static bool RunTestU01(const Source& source, std::uint64_t seed, std::string_view battery)
+{
+	void (*run)(unif01_Gen*) = nullptr;
+
+	if(battery == "smallcrush")
+	{
+		run = bbattery_SmallCrush;
+	}
+	else if(battery == "crush")
+	{
+		run = bbattery_Crush;
+	}
+	else if(battery == "bigcrush")
+	{
+		run = bbattery_BigCrush;
+	}
+	else
+	{
+		return false;
+	}
+
+	std::string name = source.Name;
+
+	_testWrite = source.Make(seed);
+	unif01_Gen* generator = unif01_CreateExternGenBits(name.data(), NextTestWord);
+	run(generator);
+	unif01_DeleteExternGenBits(generator);
+	return true;
+}
+#endif
+
+static void PrintUsage() noexcept
+{
+	std::fprintf(stderr,
+		"usage: random_quality <source> [bytes] [--seed n] [--report file]\n"
+		"       random_quality --throughput [bytes] [--seed n] [--report file]\n"
+	#if defined(RANDOM_QUALITY_TESTU01)
+		"       random_quality --testu01 smallcrush|crush|bigcrush <source> [--seed n]\n"
+	#endif
+		"  <source>      writes raw 64-bit words to stdout, endless by default, e.g. | RNG_test stdin64\n"
+		"  --throughput  generates bytes of every source without writing them, 256M by default\n"
+		"  bytes         number of bytes with an optional suffix K, M, G or T\n"
+		"  --report      appends source,bytes,seconds,bytes_per_second to a CSV file\n"
+		"sources:\n");
+
+	for(const Source& source : Sources)
+	{
+		std::fprintf(stderr, "  %-14s %s\n", source.Name, source.Description);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const Source* source = nullptr;
+	const char* report = nullptr;
+	const char* battery = nullptr;
+	std::uint64_t seed = 1;
+	std::uint64_t size = 0;
+	bool throughput = false;
+	bool sized = false;
+
+	for(int i = 1; i < argc; i++)
+	{
+		const std::string_view argument = argv[i];
+
+		if(argument == "--seed" && i + 1 < argc)
+		{
+			seed = std::strtoull(argv[++i], nullptr, 0);
+		}
+		else if(argument == "--report" && i + 1 < argc)
+		{
+			report = argv[++i];
+		}
+		else if(argument == "--throughput")
+		{
+			throughput = true;
+		}
+	#if defined(RANDOM_QUALITY_TESTU01)
+		else if(argument == "--testu01" && i + 1 < argc)
+		{
+			battery = argv[++i];
+		}
+	#endif
+		else if(source == nullptr && (source = FindSource(argument)) != nullptr)
+		{
+		}
+		else if(!sized && ParseBytes(argv[i], size))
+		{
+			sized = true;
+		}
+		else
+		{
+			PrintUsage();
+			return 2;
+		}
+	}
+
+	std::signal(SIGINT, [](int) { _stopped = 1; });
+
+	if(throughput)
+	{
+		const std::uint64_t bytes = sized ? size : std::uint64_t(256) << 20;
+
+		for(const Source& each : Sources)
+		{
+			if(source != nullptr && source != &each)
+			{
+				continue;
+			}
+
+			const auto start = std::chrono::steady_clock::now();
+			const std::uint64_t total = Run(each, seed, bytes, [](std::span<const std::byte> chunk)
+			{
+				// Read the output, so that no generation is optimized away
+				_sink = chunk.back();
+				return true;
+			});
+
+			Report(report, each, total, SecondsSince(start));
+		}
+
+		return 0;
+	}
+
+	if(source == nullptr)
+	{
+		PrintUsage();
+		return 2;
+	}
+
+#if defined(RANDOM_QUALITY_TESTU01)
+	if(battery != nullptr)
+	{
+		if(!RunTestU01(*source, seed, battery))
+		{
+			PrintUsage();
+			return 2;
+		}
+
+		return 0;
+	}
+#endif
+	static_cast<void>(battery);
+
+#if defined(_WIN32)
+	_setmode(_fileno(stdout), _O_BINARY);
+#endif
+#if defined(SIGPIPE)
+	// A test that has read enough closes the pipe, the write then fails and the throughput is still reported
+	std::signal(SIGPIPE, SIG_IGN);
+#endif
+
+	const auto start = std::chrono::steady_clock::now();
+	const std::uint64_t total = Run(*source, seed, size, [](std::span<const std::byte> chunk)
+	{
+		return std::fwrite(chunk.data(), 1, chunk.size(), stdout) == chunk.size();
+	});
+
+	std::fflush(stdout);
+	Report(report, *source, total, SecondsSince(start));
+	return 0;
+}
\ No newline at end of file
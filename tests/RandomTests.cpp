@@ -0,0 +1,631 @@
+#include <Random.h>
+
+#include <cstdio>
+#include <deque>
+#include <string_view>
+#include <vector>
+
+/// <summary>
+/// Unit tests of Random.h without a test framework. Every test is a function of checks,
+/// the process exits with 1 if any check fails:
+///
+///     ctest --test-dir build
+///     random_tests philox
+///
+/// Known answers come from the reference implementations: splitmix64.c and xoshiro256plusplus.c
+/// by S. Vigna, pcg-cpp by M. O'Neill and the kat_vectors of Random123.
+/// </summary>
+
+static int _failures = 0;
+
+static void Check(bool condition, const char* expression, int line) noexcept
+{
+	if(!condition)
+	{
+		std::fprintf(stderr, "RandomTests.cpp:%d: check failed: %s\n", line, expression);
+		_failures++;
+	}
+}
+
+#define RANDOM_CHECK(condition) Check((condition), #condition, __LINE__)
+
+/// <summary>
+/// xoshiro256++ as published by its authors, to check the engine and its jumps against
+/// </summary>
+struct ReferenceXoshiro
+{
+	std::uint64_t State[4];
+
+	static std::uint64_t RotateLeft(std::uint64_t value, int shift) noexcept
+	{
+		return (value << shift) | (value >> (64 - shift));
+	}
+
+	std::uint64_t Next() noexcept
+	{
+		const std::uint64_t result = RotateLeft(State[0] + State[3], 23) + State[0];
+		const std::uint64_t t = State[1] << 17;
+
+		State[2] ^= State[0];
+		State[3] ^= State[1];
+		State[1] ^= State[2];
+		State[0] ^= State[3];
+		State[2] ^= t;
+		State[3] = RotateLeft(State[3], 45);
+
+		return result;
+	}
+
+	void Jump(const std::uint64_t (&polynomial)[4]) noexcept
+	{
+		std::uint64_t state[4] = {};
+
+		for(int i = 0; i < 4; i++)
+		{
+			for(int bit = 0; bit < 64; bit++)
+			{
+				if(polynomial[i] & (std::uint64_t(1) << bit))
+				{
+					for(int j = 0; j < 4; j++)
+					{
+						state[j] ^= State[j];
+					}
+				}
+
+				Next();
+			}
+		}
+
+		std::memcpy(State, state, sizeof(state));
+	}
+
+	void JumpShort() noexcept
+	{
+		Jump({ 0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c });
+	}
+
+	void JumpLong() noexcept
+	{
+		Jump({ 0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241, 0x39109bb02acbe635 });
+	}
+};
+
+/// <summary>
+/// Kernels of Xoshiro256PlusPlusX8 for every instruction set, to compare each of them with the scalar lanes
+/// </summary>
+class Xoshiro256PlusPlusX8Probe: public Xoshiro256PlusPlusX8
+{
+public:
+	using Xoshiro256PlusPlusX8::Xoshiro256PlusPlusX8;
+	using Xoshiro256PlusPlusX8::FillIntsDefault;
+	using Xoshiro256PlusPlusX8::FillRealsDefault;
+	using Xoshiro256PlusPlusX8::FillBytesDefault;
+#if defined(RANDOM_X86_DISPATCH)
+	using Xoshiro256PlusPlusX8::FillIntsAvx2;
+	using Xoshiro256PlusPlusX8::FillRealsAvx2;
+	using Xoshiro256PlusPlusX8::FillBytesAvx2;
+	using Xoshiro256PlusPlusX8::FillIntsAvx512;
+	using Xoshiro256PlusPlusX8::FillRealsAvx512;
+	using Xoshiro256PlusPlusX8::FillBytesAvx512;
+#endif
+};
+
+/// <summary>
+/// The eight scalar engines behind Xoshiro256PlusPlusX8(base): lane k starts after k jumps
+/// </summary>
+static std::vector<Xoshiro256PlusPlus> MakeLanes(Xoshiro256PlusPlus base)
+{
+	std::vector<Xoshiro256PlusPlus> lanes;
+
+	for(std::size_t lane = 0; lane < Xoshiro256PlusPlusX8::Lanes; lane++)
+	{
+		lanes.push_back(base);
+		base.jump();
+	}
+
+	return lanes;
+}
+
+/// <summary>
+/// Outputs of the lanes in the order of the bulk kernels: one output of every lane per step
+/// </summary>
+static std::vector<std::uint64_t> ReferenceWords(Xoshiro256PlusPlus base, std::size_t count)
+{
+	std::vector<Xoshiro256PlusPlus> lanes = MakeLanes(base);
+	std::vector<std::uint64_t> words(count);
+
+	for(std::size_t i = 0; i < count; i++)
+	{
+		words[i] = lanes[i % Xoshiro256PlusPlusX8::Lanes]();
+	}
+
+	return words;
+}
+
+/// <summary>
+/// The bounded kernel on scalar lanes: Lemire's multiply-shift on the high halves of a step, then on the low halves.
+/// If a product of a step is rejected, the high and the low half of every lane in turn are redrawn
+/// from the halves of the next steps.
+/// </summary>
+static std::vector<std::uint32_t> ReferenceInts(Xoshiro256PlusPlus base, std::size_t count, std::uint32_t min, std::uint64_t range)
+{
+	constexpr std::size_t Lanes = Xoshiro256PlusPlusX8::Lanes;
+
+	std::vector<Xoshiro256PlusPlus> lanes = MakeLanes(base);
+	std::vector<std::uint32_t> output;
+	std::uint32_t spare[2 * Lanes];
+	std::size_t position = 2 * Lanes;
+	const std::uint32_t threshold = range > UINT32_MAX ? 0 : static_cast<std::uint32_t>((std::uint64_t(1) << 32) % range);
+
+	const auto step = [&lanes](std::uint32_t (&halves)[2 * Lanes])
+	{
+		for(std::size_t lane = 0; lane < Lanes; lane++)
+		{
+			const std::uint64_t bits = lanes[lane]();
+
+			halves[lane] = static_cast<std::uint32_t>(bits >> 32);
+			halves[Lanes + lane] = static_cast<std::uint32_t>(bits);
+		}
+	};
+
+	while(output.size() < count)
+	{
+		std::uint32_t halves[2 * Lanes];
+		bool rejected = false;
+
+		step(halves);
+
+		if(range > UINT32_MAX)
+		{
+			for(std::uint32_t half : halves)
+			{
+				output.push_back(min + half);
+			}
+
+			continue;
+		}
+
+		for(std::uint32_t half : halves)
+		{
+			rejected |= static_cast<std::uint32_t>(half * range) < threshold;
+		}
+
+		for(std::size_t lane = 0; lane < Lanes; lane++)
+		{
+			for(const std::size_t half : { lane, Lanes + lane })
+			{
+				std::uint64_t product = halves[half] * range;
+
+				while(rejected && static_cast<std::uint32_t>(product) < threshold)
+				{
+					if(position == 2 * Lanes)
+					{
+						step(spare);
+						position = 0;
+					}
+
+					product = spare[position++] * range;
+				}
+
+				halves[half] = static_cast<std::uint32_t>(product >> 32);
+			}
+		}
+
+		for(std::uint32_t value : halves)
+		{
+			output.push_back(min + value);
+		}
+	}
+
+	output.resize(count);
+	return output;
+}
+
+/// <summary>
+/// The reals kernel on scalar lanes: doubles take 53 bits, floats the high 24 bits of an output
+/// </summary>
+template<typename TReal>
+static std::vector<TReal> ReferenceReals(Xoshiro256PlusPlus base, std::size_t count, double min, double max)
+{
+	const std::vector<std::uint64_t> words = ReferenceWords(base, count);
+	const TReal bound = RandomBits::UpperBound(static_cast<TReal>(min), static_cast<TReal>(max));
+	std::vector<TReal> output(count);
+
+	for(std::size_t i = 0; i < count; i++)
+	{
+		const double unit = std::is_same_v<TReal, float> ? static_cast<double>(words[i] >> 40) * 0x1.0p-24 : RandomBits::ToDouble(words[i]);
+		output[i] = std::min(static_cast<TReal>(min + unit * (max - min)), bound);
+	}
+
+	return output;
+}
+
+static void TestSplitMix64()
+{
+	// splitmix64.c seeded with 1234567
+	SplitMix64 engine(1234567);
+
+	RANDOM_CHECK(engine() == 6457827717110365317u);
+	RANDOM_CHECK(engine() == 3203168211198807973u);
+	RANDOM_CHECK(engine() == 9817491932198370423u);
+	RANDOM_CHECK(engine() == 4593380528125082431u);
+	RANDOM_CHECK(engine() == 16408922859458223821u);
+}
+
+static void TestXoshiro256PlusPlus()
+{
+	BasicRandom<Xoshiro256PlusPlus> random{ Xoshiro256PlusPlus() };
+	RandomState<Xoshiro256PlusPlus> state;
+	const std::uint64_t words[4] = { 1, 2, 3, 4 };
+
+	// The first output of the state { 1, 2, 3, 4 } is rotl(1 + 4, 23) + 1
+	std::memcpy(state.Engine, words, sizeof(words));
+	RANDOM_CHECK(random.LoadState(state));
+	RANDOM_CHECK(random.NextInt64(std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max()) == 41943041);
+
+	// The seed is expanded by SplitMix64 as the authors recommend
+	for(const std::uint64_t seed : { std::uint64_t(0), std::uint64_t(42), std::uint64_t(0xdeadbeefcafef00d) })
+	{
+		SplitMix64 expander(seed);
+		ReferenceXoshiro reference{ { expander(), expander(), expander(), expander() } };
+		Xoshiro256PlusPlus engine(seed);
+		bool same = true;
+
+		for(int i = 0; i < 1000; i++)
+		{
+			same &= engine() == reference.Next();
+		}
+
+		engine.jump();
+		reference.JumpShort();
+
+		for(int i = 0; i < 1000; i++)
+		{
+			same &= engine() == reference.Next();
+		}
+
+		engine.long_jump();
+		reference.JumpLong();
+
+		for(int i = 0; i < 1000; i++)
+		{
+			same &= engine() == reference.Next();
+		}
+
+		RANDOM_CHECK(same);
+	}
+}
+
+static void TestPcg64()
+{
+	// pcg64 of pcg-cpp seeded with 42 on the stream 54
+	Pcg64 engine(42, 54);
+
+	RANDOM_CHECK(engine() == 0x86b1da1d72062b68);
+	RANDOM_CHECK(engine() == 0x1304aa46c9853d39);
+	RANDOM_CHECK(engine() == 0xa3670e9e0dd50358);
+	RANDOM_CHECK(engine() == 0xf9090e529a7dae00);
+	RANDOM_CHECK(engine() == 0xc85b9fd837996f2c);
+	RANDOM_CHECK(engine() == 0x606121f8e3919196);
+
+	Pcg64 skipped(42, 54);
+	Pcg64 stepped(42, 54);
+
+	skipped.discard(1000);
+
+	for(int i = 0; i < 1000; i++)
+	{
+		stepped();
+	}
+
+	RANDOM_CHECK(skipped == stepped);
+}
+
+static void TestPhilox()
+{
+	// kat_vectors of Random123 for philox4x32_10: the counter is (block number, stream), the key is the seed
+	const struct
+	{
+		std::uint64_t Key, Stream, Counter;
+		std::uint32_t Block[4];
+	}
+	answers[] =
+	{
+		{ 0, 0, 0, { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 } },
+		{ ~std::uint64_t(0), ~std::uint64_t(0), ~std::uint64_t(0), { 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd } },
+		{ 0x299f31d0a4093822, 0x0370734413198a2e, 0x85a308d3243f6a88, { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 } }
+	};
+
+	for(const auto& answer : answers)
+	{
+		std::uint32_t block[4];
+		Philox4x32 engine(answer.Key, answer.Stream);
+
+		PhiloxKernel::Block(answer.Key, answer.Stream, answer.Counter, block);
+		RANDOM_CHECK(std::equal(block, block + 4, answer.Block));
+
+		// Element 2 * counter + lane holds the lane-th 64 bits of the block, elements reach the blocks under 2^63
+		if(answer.Counter < std::uint64_t(1) << 63)
+		{
+			engine.Seek(answer.Stream, 2 * answer.Counter);
+			RANDOM_CHECK(engine() == (answer.Block[0] | std::uint64_t(answer.Block[1]) << 32));
+			RANDOM_CHECK(engine() == (answer.Block[2] | std::uint64_t(answer.Block[3]) << 32));
+		}
+	}
+
+	static_assert(Philox4x32(7, 3).At(3, 5) == PhiloxKernel::Bits(7, 3, 5));
+}
+
+/// <summary>
+/// PhiloxKernel::Fill, as a device kernel calls it, against Philox4x32::At and the PhiloxRandom paths on the host
+/// </summary>
+static void TestPhiloxKernel()
+{
+	constexpr std::uint64_t Key = 0x0123456789abcdef, Stream = 9;
+	const Philox4x32 engine(Key, Stream);
+
+	for(const std::uint64_t offset : { 0, 1, 2, 7 })
+	{
+		for(const std::size_t count : { 0, 1, 2, 3, 100 })
+		{
+			std::vector<std::uint64_t> bits(count), expected(count);
+			std::vector<double> reals(count), filled(count);
+			bool same = true;
+
+			PhiloxKernel::Fill(bits.data(), count, Key, Stream, offset);
+			PhiloxKernel::Fill(reals.data(), count, Key, Stream, offset);
+			engine.Fill(filled, offset);
+
+			for(std::size_t i = 0; i < count; i++)
+			{
+				expected[i] = engine.At(Stream, offset + i);
+				same &= reals[i] == PhiloxKernel::Convert<double>(expected[i]);
+			}
+
+			RANDOM_CHECK(bits == expected);
+			RANDOM_CHECK(reals == filled);
+			RANDOM_CHECK(same);
+		}
+	}
+
+	PhiloxRandom random{ Philox4x32(Key) };
+	std::vector<double> units(1001), device(1001);
+	std::vector<float> reals(77), deviceReals(77);
+	std::vector<std::uint64_t> words(50), deviceWords(50);
+	std::vector<std::byte> bytes(403);
+	bool same = true;
+
+	random.Seek(Stream, 5);
+	random.Fill(units);
+	random.Fill(reals, -2.0f, 3.0f);
+	random.Fill(words, std::uint64_t(0), std::numeric_limits<std::uint64_t>::max());
+	random.FillBytes(bytes);
+
+	PhiloxKernel::Fill(device.data(), device.size(), Key, Stream, 5);
+	PhiloxKernel::Fill(deviceReals.data(), deviceReals.size(), Key, Stream, 1006);
+	PhiloxKernel::Fill(deviceWords.data(), deviceWords.size(), Key, Stream, 1083);
+
+	for(std::size_t i = 0; i < reals.size(); i++)
+	{
+		same &= reals[i] == std::min(-2.0f + 5.0f * deviceReals[i], RandomBits::UpperBound(-2.0f, 3.0f));
+	}
+
+	for(std::size_t i = 0; i + sizeof(std::uint64_t) <= bytes.size(); i += sizeof(std::uint64_t))
+	{
+		std::uint64_t word;
+
+		std::memcpy(&word, bytes.data() + i, sizeof(word));
+		same &= word == PhiloxKernel::Bits(Key, Stream, 1133 + i / sizeof(word));
+	}
+
+	RANDOM_CHECK(units == device);
+	RANDOM_CHECK(words == deviceWords);
+	RANDOM_CHECK(same);
+	RANDOM_CHECK(random.At(Stream, 1184) == PhiloxKernel::Bits(Key, Stream, 1184));
+}
+
+/// <summary>
+/// Every vectorized kernel of Xoshiro256PlusPlusX8 against the eight scalar engines of its lanes
+/// </summary>
+static void TestBulkKernels()
+{
+	const Xoshiro256PlusPlus base(2024);
+
+	// 1000 is no multiple of a step, so the tails are checked too
+	for(const std::size_t count : { 1000, 5 })
+	{
+		const std::vector<std::uint64_t> words = ReferenceWords(base, count);
+		const std::vector<double> doubles = ReferenceReals<double>(base, count, 0.0, 1.0);
+		const std::vector<double> scaledDoubles = ReferenceReals<double>(base, count, -3.0, 5.0);
+		const std::vector<float> floats = ReferenceReals<float>(base, count, -3.0, 5.0);
+
+		const auto checkKernels = [&](auto&& fillBytes, auto&& fillDoubles, auto&& fillFloats)
+		{
+			std::vector<std::uint64_t> outputWords(count);
+			std::vector<double> outputDoubles(count), outputScaled(count);
+			std::vector<float> outputFloats(count);
+
+			fillBytes(reinterpret_cast<std::byte*>(outputWords.data()), count * sizeof(std::uint64_t));
+			fillDoubles(outputDoubles.data(), 0.0, 1.0);
+			fillDoubles(outputScaled.data(), -3.0, 5.0);
+			fillFloats(outputFloats.data(), -3.0, 5.0);
+
+			RANDOM_CHECK(outputWords == words);
+			RANDOM_CHECK(outputDoubles == doubles);
+			RANDOM_CHECK(outputScaled == scaledDoubles);
+			RANDOM_CHECK(outputFloats == floats);
+		};
+
+		checkKernels([&](std::byte* output, std::size_t size) { Xoshiro256PlusPlusX8(base).FillBytes(output, size); },
+					 [&](double* output, double min, double max) { Xoshiro256PlusPlusX8(base).FillReals(output, count, min, max); },
+					 [&](float* output, double min, double max) { Xoshiro256PlusPlusX8(base).FillReals(output, count, static_cast<float>(min), static_cast<float>(max)); });
+		checkKernels([&](std::byte* output, std::size_t size) { Xoshiro256PlusPlusX8Probe(base).FillBytesDefault(output, size); },
+					 [&](double* output, double min, double max) { Xoshiro256PlusPlusX8Probe(base).FillRealsDefault(output, count, min, max); },
+					 [&](float* output, double min, double max) { Xoshiro256PlusPlusX8Probe(base).FillRealsDefault(output, count, min, max); });
+	#if defined(RANDOM_X86_DISPATCH)
+		if(__builtin_cpu_supports("avx2"))
+		{
+			checkKernels([&](std::byte* output, std::size_t size) { Xoshiro256PlusPlusX8Probe(base).FillBytesAvx2(output, size); },
+						 [&](double* output, double min, double max) { Xoshiro256PlusPlusX8Probe(base).FillRealsAvx2(output, count, min, max); },
+						 [&](float* output, double min, double max) { Xoshiro256PlusPlusX8Probe(base).FillRealsAvx2(output, count, min, max); });
+		}
+
+		if(__builtin_cpu_supports("avx512f"))
+		{
+			checkKernels([&](std::byte* output, std::size_t size) { Xoshiro256PlusPlusX8Probe(base).FillBytesAvx512(output, size); },
+						 [&](double* output, double min, double max) { Xoshiro256PlusPlusX8Probe(base).FillRealsAvx512(output, count, min, max); },
+						 [&](float* output, double min, double max) { Xoshiro256PlusPlusX8Probe(base).FillRealsAvx512(output, count, min, max); });
+		}
+	#endif
+
+		// Under a half of the products of the last two ranges are accepted, so most steps take redraws
+		for(const std::uint64_t range : { std::uint64_t(6), std::uint64_t(1000), std::uint64_t(0x80000001), std::uint64_t(0xc0000001), std::uint64_t(1) << 32 })
+		{
+			const std::uint32_t min = 17;
+			const std::vector<std::uint32_t> ints = ReferenceInts(base, count, min, range);
+			std::vector<std::uint32_t> output(count);
+
+			Xoshiro256PlusPlusX8(base).FillInts(output.data(), count, min, static_cast<std::uint32_t>(min + range - 1));
+			RANDOM_CHECK(output == ints);
+
+			Xoshiro256PlusPlusX8Probe(base).FillIntsDefault(output.data(), count, min, range);
+			RANDOM_CHECK(output == ints);
+		#if defined(RANDOM_X86_DISPATCH)
+			if(__builtin_cpu_supports("avx2"))
+			{
+				Xoshiro256PlusPlusX8Probe(base).FillIntsAvx2(output.data(), count, min, range);
+				RANDOM_CHECK(output == ints);
+			}
+
+			if(__builtin_cpu_supports("avx512f"))
+			{
+				Xoshiro256PlusPlusX8Probe(base).FillIntsAvx512(output.data(), count, min, range);
+				RANDOM_CHECK(output == ints);
+			}
+		#endif
+		}
+	}
+}
+
+/// <summary>
+/// SaveState and LoadState of engines with a plain state, and images of another engine type refused
+/// </summary>
+template<typename TEngine>
+static void TestStateRoundTrip(TEngine engine)
+{
+	BasicRandom<TEngine> random{ engine };
+	std::vector<std::uint64_t> first(300), second(300);
+
+	random.Fill(first, std::uint64_t(0), std::numeric_limits<std::uint64_t>::max());
+
+	const RandomState<TEngine> state = random.SaveState();
+
+	random.Fill(first, std::uint64_t(0), std::numeric_limits<std::uint64_t>::max());
+	RANDOM_CHECK(state.IsValid());
+	RANDOM_CHECK(random.LoadState(state));
+	random.Fill(second, std::uint64_t(0), std::numeric_limits<std::uint64_t>::max());
+	RANDOM_CHECK(first == second);
+
+	RANDOM_CHECK(random.LoadState(std::as_bytes(std::span(&state, 1))));
+	random.Fill(second, std::uint64_t(0), std::numeric_limits<std::uint64_t>::max());
+	RANDOM_CHECK(first == second);
+
+	RandomState<TEngine> other = state;
+
+	other.Version++;
+	RANDOM_CHECK(!random.LoadState(other));
+}
+
+static void TestState()
+{
+	TestStateRoundTrip(SplitMix64(5));
+	TestStateRoundTrip(Xoshiro256PlusPlus(5));
+	TestStateRoundTrip(Pcg64(5, 7));
+	TestStateRoundTrip(Philox4x32(5, 7));
+	TestStateRoundTrip(std::mt19937_64(5));
+}
+
+/// <summary>
+/// Fill of bool ranges gives both values with equal probabilities on every path
+/// </summary>
+static void TestFillBool()
+{
+	constexpr std::size_t Size = 100000;
+
+	const auto isBalanced = [](const auto& range)
+	{
+		std::size_t ones = 0;
+
+		for(const bool value : range)
+		{
+			ones += value;
+		}
+
+		// Five standard deviations of a binomial distribution
+		return ones > Size / 2 - 800 && ones < Size / 2 + 800;
+	};
+
+	Random random(11);
+	PhiloxRandom philox(11);
+	std::vector<bool> bits(Size);
+	std::deque<bool> queue(Size);
+	auto array = std::make_unique<std::array<bool, Size>>();
+
+	random.Fill(bits, false, true);
+	RANDOM_CHECK(isBalanced(bits));
+	random.Fill(queue, false, true);
+	RANDOM_CHECK(isBalanced(queue));
+	random.Fill(*array, false, true);
+	RANDOM_CHECK(isBalanced(*array));
+
+	philox.Fill(bits, false, true);
+	RANDOM_CHECK(isBalanced(bits));
+	philox.Fill(*array, 3);
+	RANDOM_CHECK(isBalanced(*array));
+	philox.Fill(bits, 3);
+	RANDOM_CHECK(std::equal(bits.begin(), bits.end(), array->begin()));
+	RANDOM_CHECK(PhiloxKernel::Convert<bool>(std::uint64_t(1) << 63) && !PhiloxKernel::Convert<bool>(~std::uint64_t(0) >> 1));
+}
+
+static const struct
+{
+	const char* Name;
+	void (*Run)();
+}
+Tests[] =
+{
+	{ "splitmix", TestSplitMix64 },
+	{ "xoshiro", TestXoshiro256PlusPlus },
+	{ "pcg", TestPcg64 },
+	{ "philox", TestPhilox },
+	{ "philoxkernel", TestPhiloxKernel },
+	{ "bulk", TestBulkKernels },
+	{ "state", TestState },
+	{ "bool", TestFillBool }
+};
+
+int main(int argc, char** argv)
+{
+	const std::string_view filter = argc > 1 ? argv[1] : "";
+	bool found = false;
+
+	for(const auto& test : Tests)
+	{
+		if(filter.empty() || filter == test.Name)
+		{
+			const int failures = _failures;
+
+			test.Run();
+			found = true;
+			std::printf("%-14s %s\n", test.Name, _failures == failures ? "passed" : "FAILED");
+		}
+	}
+
+	if(!found)
+	{
+		std::fprintf(stderr, "unknown test %s\n", argv[1]);
+		return 2;
+	}
+
+	return _failures == 0 ? 0 : 1;
+}
\ No newline at end of file